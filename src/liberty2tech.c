@@ -13,10 +13,8 @@
 #include <string.h>
 #include <errno.h>
 #include <stdarg.h>
- 
-#define LIB_LINE_MAX  65535
 
-int libCurrentLine;
+#include "tokenstream.h"
 
 #define INIT		0
 #define LIBBLOCK	1
@@ -82,135 +80,6 @@ typedef struct _cell {
     cellptr next;
 } cell;
 
-/*--------------------------------------------------------------*/
-/* Grab a token from the input					*/
-/* Return the token, or NULL if we have reached end-of-file.	*/
-/*--------------------------------------------------------------*/
-
-char *
-advancetoken(FILE *flib, char delimiter)
-{
-    static char token[LIB_LINE_MAX];
-    static char line[LIB_LINE_MAX];
-    static char *linepos = NULL;
-
-    char *lineptr = linepos;
-    char *lptr, *tptr;
-    char *result;
-    int commentblock, concat, nest;
-
-    commentblock = 0;
-    concat = 0;
-    nest = 0;
-    while (1) {		/* Keep processing until we get a token or hit EOF */
-
-	if (lineptr != NULL && *lineptr == '/' && *(lineptr + 1) == '*') {
-	    commentblock = 1;
-	}
-
-	if (commentblock == 1) {
-	    if ((lptr = strstr(lineptr, "*/")) != NULL) {
-		lineptr = lptr + 2;
-		commentblock = 0;
-	    }
-	    else lineptr = NULL;
-	}
-
-	if (lineptr == NULL || *lineptr == '\n' || *lineptr == '\0') {
-	    result = fgets(line, LIB_LINE_MAX, flib);
-	    libCurrentLine++;
-	    if (result == NULL) return NULL;
-
-	    /* Keep pulling stuff in if the line ends with a continuation character */
- 	    lptr = line;
-	    while (*lptr != '\n' && *lptr != '\0') {
-		if (*lptr == '\\') {
-		    result = fgets(lptr, LIB_LINE_MAX - (lptr - line), flib);
-		    libCurrentLine++;
-		    if (result == NULL) break;
-		}
-		else
-		    lptr++;
-	    }	
-	    if (result == NULL) return NULL;
-	    lineptr = line;
-	}
-
-	if (commentblock == 1) continue;
-
-	while (isspace(*lineptr)) lineptr++;
-	if (concat == 0)
-	    tptr = token;
-
-	// Find the next token and return just the token.  Update linepos
-	// to the position just beyond the token.  All delimiters like
-	// parentheses, quotes, etc., are returned as single tokens
-
-	// If delimiter is declared, then we stop when we reach the
-	// delimiter character, and return all the text preceding it
-	// as the token.  If delimiter is 0, then we look for standard
-	// delimiters, and separate them out and return them as tokens
-	// if found.
-
-	while (1) {
-	    if (*lineptr == '\n' || *lineptr == '\0')
-		break;
-	    if (*lineptr == '/' && *(lineptr + 1) == '*')
-		break;
-	    if (delimiter != 0 && *lineptr == delimiter) {
-		if (nest > 0)
-		    nest--;
-		else
-		    break;
-	    }
-
-	    // Watch for nested delimiters!
-	    if (delimiter == '}' && *lineptr == '{') nest++;
-	    if (delimiter == ')' && *lineptr == '(') nest++;
-
-	    if (delimiter == 0)
-		if (*lineptr == ' ' || *lineptr == '\t')
-		    break;
-
-	    if (delimiter == 0) {
-		if (*lineptr == '(' || *lineptr == ')') {
-		    if (tptr == token) *tptr++ = *lineptr++;
-		    break;
-		}
-		if (*lineptr == '{' || *lineptr == '}') {
-		    if (tptr == token) *tptr++ = *lineptr++;
-		    break;
-		}
-		if (*lineptr == '\"' || *lineptr == ':' || *lineptr == ';') {
-		    if (tptr == token) *tptr++ = *lineptr++;
-		    break;
-		}
-	    }
-
-	    *tptr++ = *lineptr++;
-	}
-	*tptr = '\0';
-	if ((delimiter != 0) && (*lineptr != delimiter))
-	    concat = 1;
-	else if ((delimiter != 0) && (*lineptr == delimiter))
-	    break;
-	else if (tptr > token)
-	    break;
-    }
-    if (delimiter != 0) lineptr++;
-
-    while (isspace(*lineptr)) lineptr++;
-    linepos = lineptr;
-
-    // Final:  Remove trailing whitespace
-    tptr = token + strlen(token) - 1;
-    while (isspace(*tptr)) {
-	*tptr = '\0';
-	tptr--;
-    }
-    return token;
-}
-
 /*--------------------------------------------------------------*/
 /* Expansion of XOR operator "^" into and/or/invert		*/
 /*--------------------------------------------------------------*/
@@ -477,7 +346,7 @@ pattern_match(char *name, char *pattern)
 int
 main(int objc, char *argv[])
 {
-    FILE *flib;
+    tokenstream *flib;
     FILE *fgen;
     FILE *fcfg;
     char *token;
@@ -505,7 +374,7 @@ main(int objc, char *argv[])
     }
     if (objc == 5) pattern = strdup(argv[4]);
 
-    flib = fopen(argv[1], "r");
+    flib = tokenstream_open(argv[1]);
     if (flib == NULL) {
 	fprintf(stderr, "Cannot open %s for reading\n", argv[1]);
 	exit (1);
@@ -513,7 +382,6 @@ main(int objc, char *argv[])
 
     /* Read the file.  This is not a rigorous parser! */
 
-    libCurrentLine = 0;
     lastcell = NULL;
 
     /* Read tokens off of the line */
@@ -548,7 +416,7 @@ main(int objc, char *argv[])
 		// Here we check for the main blocks, again not rigorously. . .
 
 		if (!strcasecmp(token, "}")) {
-		    fprintf(stdout, "End of library at line %d\n", libCurrentLine);
+		    fprintf(stdout, "End of library at line %d\n", flib->line);
 		    section = INIT;			// End of library block
 		}
 		else if (!strcasecmp(token, "delay_model")) {
@@ -1156,9 +1024,12 @@ main(int objc, char *argv[])
 	}
 	token = advancetoken(flib, 0);
     }
-    fprintf(stdout, "Lib Read:  Processed %d lines.\n", libCurrentLine);
+    fprintf(stdout, "Lib Read:  Processed %d lines.\n", flib->line);
 
-    if (flib != NULL) fclose(flib);
+    if ((flib != NULL) && (tokenstream_close(flib) < 0)) {
+	fprintf(stderr, "Compressed file %s is corrupt or truncated\n", argv[1]);
+	exit (1);
+    }
 
     /* Temporary:  Print information gathered */
 
@@ -0,0 +1,9981 @@
+/*--------------------------------------------------------------*/
+/* libvesta.c ---						*/
+/*								*/
+/*	Static timing analysis library used by vesta (see	*/
+/*	vesta.c), with the C interface declared in vesta.h.	*/
+/*	It reads two files:  (1) A verilog netlist file of a	*/
+/*	circuit (structural verilog, that is, gate-level	*/
+/*	information only), and (2) a liberty format file 	*/
+/*	containing timing information for the standard cell 	*/
+/*	macros instantiated in the verilog netlist.  In		*/
+/*	addition, it may take an optional third file containing	*/
+/*	information about the resistance and capacitance of the	*/
+/*	wiring (see below).					*/
+/*								*/
+/*	The timing report is a list of paths with negative	*/
+/*	slack.  If no paths have negative slack, then the 20	*/
+/*	paths with the smallest positive slack are output,	*/
+/*	following a "success" message.  If no clock period is	*/
+/*	supplied, then the clock period is set to equal the	*/
+/*	delay of the longest delay path, and the 20 paths with	*/
+/*	the smallest positive slack are output, following a	*/
+/*	statement indicated the computed minimum clock period.	*/
+/*	The number of paths output can be changed, and the	*/
+/*	number output for any one endpoint limited (see		*/
+/*	vestaopts).						*/
+/*								*/
+/*	The required time and slack of every connection may	*/
+/*	also be found, in one backward pass over the timing	*/
+/*	graph, and written as a slack map for the use of other	*/
+/*	tools (see build_slack_map()).				*/
+/*								*/
+/*	More than one liberty file may be given, one for each	*/
+/*	process corner.  The netlist is read with the first,	*/
+/*	and each corner is timed on the same netlist, in	*/
+/*	parallel, followed by a summary of all corners.		*/
+/*--------------------------------------------------------------*/
+
+/*--------------------------------------------------------------*/
+/*	Wiring delay file:					*/
+/*	For qflow, the wiring delay is generated by the tool	*/
+/*	"def2delays".  The file format is as follows:		*/
+/*								*/
+/*	<net_name>						*/
+/*	<output_terminal> [<net_capacitance>]			*/
+/*	<input_terminal_1> <delay_1>				*/
+/*	...							*/
+/*	<input_terminal_N> <delay_N>				*/
+/*								*/
+/*	Optional value <net_capacitance> is in fF		*/
+/*	Values <delay_i> are in ps				*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <string.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include <math.h>	// Temporary, for fabs()
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// The name "connect" is used for the connection record type below, so
+// hide the socket library's connect(), which is not needed here.
+#define connect socket_connect
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "vesta.h"
+#include "vestatool.h"
+#undef connect
+#include "tokenstream.h"
+ 
+#define LIB_LINE_MAX  65535
+
+// Analysis types --- note that maximum flop-to-flop delay
+// requires calculating minimum clock skew time, and vice
+// versa, so it is necessary that these have TRUE/FALSE
+// values.
+
+#define MINIMUM_TIME	0
+#define MAXIMUM_TIME	1
+
+// Bit for each analysis type in a set of analyses run together
+
+#define ANALYSIS(minmax)	(1 << (minmax))
+#define BOTH_ANALYSES		(ANALYSIS(MINIMUM_TIME) | ANALYSIS(MAXIMUM_TIME))
+
+// Sign by which times are multiplied so that the worse time of either
+// analysis is the greater (1 for maximum time, -1 for minimum time).
+// TIME_WORSE() is true if time "a" is worse than time "b" (later for
+// maximum time, earlier for minimum time), and TIME_WORST() is the
+// worse of the two.  These compare without branching on "minmax".
+
+#define TIME_SIGN(minmax)	((double)(2 * (minmax) - 1))
+#define TIME_WORSE(minmax, a, b) (TIME_SIGN(minmax) * (a) > TIME_SIGN(minmax) * (b))
+#define TIME_WORST(minmax, a, b) (TIME_WORSE(minmax, a, b) ? (a) : (b))
+
+// Pruning of the depth-first path search (see vesta.h and
+// find_path_delay())
+
+#define PRUNE_DELAY	VESTA_PRUNE_DELAY
+#define PRUNE_PARETO	VESTA_PRUNE_PARETO
+#define PRUNE_NONE	VESTA_PRUNE_NONE
+
+// Largest number of arrivals kept per connection and analysis by
+// PRUNE_PARETO.  Arrivals beyond this are not kept, which only makes
+// the pruning less effective.
+
+#define PARETO_MAX	8
+
+// Multiple-use definition
+#define	UNKNOWN		-1
+
+// Sections of liberty file
+#define INIT		0
+#define LIBBLOCK	1
+#define CELLDEF		2
+#define PINDEF		3
+#define FLOPDEF		4
+#define LATCHDEF	5
+#define TIMING		6
+
+// Sections of verilog file
+#define MODULE		0
+#define IOLIST		1
+#define GATELIST	2
+#define INSTANCE	3
+#define INSTPIN		4
+#define PINCONN		5
+
+// Pin types (these are masks---e.g., a pin can be an INPUT and a CLOCK)
+#define INPUT		0x01	// The default
+#define OUTPUT		0x02
+#define DFFCLK		0x04
+#define DFFIN		0x08	// Flop input
+#define DFFOUT		0x10	// Flop output
+#define DFFSET		0x20	// Flop set (preset)
+#define DFFRST		0x40	// Flop reset (clear)
+#define LATCHIN		0x80	// Latch input
+#define LATCHEN		0x100	// Latch enable
+
+// Timing type (for tables)
+
+#define TIMING_PROP_TRANS	0
+#define TIMING_HOLD		1
+#define TIMING_SETUP		2
+#define TIMING_SET_RESET	3
+#define TIMING_RECOVERY		4
+#define TIMING_REMOVAL		5
+#define TIMING_TRISTATE		6
+
+// A few short-hand definitions
+#define DFF_ALL_IN	(DFFCLK | DFFIN | DFFSET | DFFRST)	
+#define LATCH_ALL_IN	(LATCHIN | LATCHEN)
+
+#define DFF_IN_NOT_CLK	(DFFIN | DFFSET | DFFRST)	
+#define LATCH_IN_NOT_EN	(LATCHIN)
+
+#define REGISTER_IN	(DFF_ALL_IN | LATCH_ALL_IN)
+#define REG_IN_NOT_CLK	(DFF_IN_NOT_CLK | LATCH_IN_NOT_EN)
+
+#define IOMASK		0x03
+#define DFFMASK		0x7c
+#define LATCHMASK	0x180
+
+// Pin sense
+#define SENSE_UNKNOWN	0	// Sense unknown
+#define SENSE_NONE	1	// Non-unate
+#define SENSE_POSITIVE	2	// Positive-unate
+#define SENSE_NEGATIVE	3	// Negative-unate
+
+// Signal transition direction
+#define EDGE_UNKNOWN	0
+#define RISING		1
+#define FALLING		2
+#define EITHER		3
+#define EDGE_MOVED	-1	// Backtrace record copied (see copy_backtrace())
+
+// Function translation
+#define GROUPBEGIN	1
+#define GROUPEND	2
+#define SIGNAL		3
+#define OPERATOR	4
+#define XOPERATOR	5
+#define SEPARATOR	6
+
+// Net types
+#define	NET		0x00	// Ordinary net (default)
+#define	CLOCK		0x01	// Clock net (path start)
+#define OUTTERM		0x02	// Module output
+#define	ASYNC		0x04	// Asynchronous set/reset
+#define TERMINAL	0x08	// DFF input (path terminal)
+#define LATCHTERM	0x10	// Latch input (dependent path terminal)
+#define ENABLE		0x20	// Latch enable (path start)
+
+// Cell types
+#define GATE		0x00	// Combinatorial gate (default)
+#define DFF		0x01	// Flip-flop (shared bit field)
+#define CLK_SENSE_MASK	0x02	// Clock edge mask (0=positive, 1=negative)
+#define RST_MASK	0x04	// Reset mask (0=no reset, 1=reset)
+#define RST_SENSE_MASK	0x08	// Reset edge mask (0=positive, 1=negative)
+#define SET_MASK	0x10	// Set mask (0=no set, 1=set)
+#define SET_SENSE_MASK	0x20	// Set edge mask (0=positive, 1=negative)
+#define LATCH		0x40	// Latch type
+#define EN_SENSE_MASK	0x80	// Latch enable edge mask (0=positive, 1=negative)
+
+// Some names for cell types based on masks
+
+#define DFFCP		0x01	// Pos clock
+#define DFFCN		0x03	// Neg clock
+#define DFFCPRP		0x05	// Pos clock, Pos reset
+#define DFFCNRP		0x07	// Neg clock, Pos reset
+#define DFFCPRN		0x0d	// Pos clock, Neg reset
+#define DFFCNRN		0x0f	// Neg clock, Neg reset
+#define DFFCPSP		0x11	// Pos clock, Pos set
+#define DFFCNSP		0x13	// Neg clock, Pos set
+#define DFFCPRPSP	0x15	// Pos clock, Pos reset, Pos set
+#define DFFCNRPSP	0x17	// Neg clock, Pos reset, Pos set
+#define DFFCPRNSP	0x1d	// Pos clock, Neg reset, Pos set
+#define DFFCNRNSP	0x1f	// Neg clock, Neg reset, Pos set
+#define DFFCPSN		0x31	// Pos clock, Neg set
+#define DFFCNSN		0x33	// Neg clock, Neg set
+#define DFFCPRPSN	0x35	// Pos clock, Pos reset, Neg set
+#define DFFCNRPSN	0x37	// Neg clock, Pos reset, Neg set
+#define DFFCPRNSN	0x3d	// Pos clock, Neg reset, Neg set
+#define DFFCNRNSN	0x3f	// Neg clock, Neg reset, Neg set
+
+/*--------------------------------------------------------------*/
+/* Liberty file database					*/
+/*--------------------------------------------------------------*/
+
+// Types of array
+
+// Array type 1:  Propagation time
+#define OUTPUT_CAP		0	
+#define TRANSITION_TIME		1
+
+// Array type 2:  Setup, hold, recovery, removal times
+#define RELATED_TIME		2
+#define CONSTRAINED_TIME	3
+
+typedef struct _lutable *lutableptr;
+
+typedef struct _lutable {
+    char *name;
+    char invert;	// 0 if times x caps, 1 if caps x times
+    int  var1;		// Type of array in index1
+    int  var2;		// Type of array in index2
+    int  size1;		// Number of entries in time array
+    int  size2;		// Number of entries in cap (or constrained timing) array
+    union {
+        double *times;	// Time array (units ps)
+        double *rel;	// Related pin transition time array (units ps)
+    } idx1;
+    union {
+        double *caps;	// Cap array (units fF)
+        double *cons;	// Constrained pin transition time array (units ps)
+    } idx2;
+    double *values;	// Matrix of values (used locally, not for templates)
+    lutableptr next;
+} lutable;
+
+typedef struct _pin *pinptr;
+typedef struct _cell *cellptr;
+
+typedef struct _pin {
+    char *name;
+    short type;
+
+    double capr;	// Capacitance for rising input
+    double capf;	// Capacitance for falling input (optional)
+
+    short sense;	// Sense (positive-unate, negative-unate, non-unate)
+    lutable *propdelr;	// Reference table for rising output prop delay relative to driver
+    lutable *propdelf;	// Reference table for falling output prop delay relative to driver
+    lutable *transr;	// Reference table for transition rise time
+    lutable *transf;	// Reference table for transition fall time
+
+    cellptr refcell;	// Pointer back to parent cell
+
+    pinptr next;
+} pin;
+
+typedef struct _cell {
+    short type;
+    char *name;
+    char *function;
+    pin	 *pins;		/* List of input pins with timing info */
+    double area;
+    double maxtrans;	/* Maximum transition time */
+    double maxcap;	/* Maximum allowable load */
+    cellptr next;
+} cell;
+
+// Binary liberty cache file header.  Pointers in the cache are stored
+// as offsets from the start of the file.
+
+#define LIBCACHE_MAGIC		"VESTALIB"
+#define LIBCACHE_VERSION	3
+
+typedef struct _libcache {
+    char    magic[8];
+    int	    version;
+    int	    ptrsize;		// sizeof(void *) of the program that wrote it
+    unsigned long srchash;	// Hash of the liberty file contents
+    unsigned long imagehash;	// Hash of the file following the header
+    size_t  size;		// Total size of the cache file
+    size_t  relocs;		// Offset of the list of pointer positions
+    long    numrelocs;		// Number of pointers
+    lutable *tables;		// Table templates
+    cell    *cells;
+} libcache;
+
+// Buffer used to build the cache image
+
+typedef struct _cachebuf {
+    char    *data;
+    size_t  size;
+    size_t  alloc;
+    size_t  *relocs;		// Positions of pointers in "data"
+    long    numrelocs;
+    long    allocrelocs;
+} cachebuf;
+
+/*--------------------------------------------------------------*/
+/* Verilog netlist database					*/
+/*--------------------------------------------------------------*/
+
+typedef struct _net *netptr;
+typedef struct _connect *connptr;
+typedef struct _delaydata *ddataptr;
+
+typedef struct _net {
+   char *name;
+   connptr driver;
+   short type;
+   int fanout;
+   connptr *receivers;
+   double loadr;	/* Total load capacitance for rising input */
+   double loadf;	/* Total load capacitance for falling input */
+   netptr next;
+} net;
+
+typedef struct _instance *instptr;
+
+typedef struct _connect {
+   instptr  refinst;
+   pinptr   refpin;
+   netptr   refnet;
+   int	    index;		/* Node index in the timing graph */
+   double   **vectors;		/* Vectors at load condition (see vecpool_get()) */
+   connptr  next;
+} connect;
+
+typedef struct _instance {
+   char *name;
+   cellptr refcell;
+   connptr in_connects;
+   connptr out_connects;
+   instptr next;
+} instance;
+
+// Linked list of delays (backtrace to source)
+
+typedef struct _btdata *btptr;
+
+typedef struct _btdata {
+   double  delay;	/* Propagation delay to this point */
+   double  trans;	/* Transition time at this point */
+   short   dir;		/* Edge direction at this point */
+   connptr receiver;	/* Receiver connection at end of path */
+   btptr   next;	/* Path of propagation */
+} btdata;
+
+// Linked list of backtrace records
+
+typedef struct _delaydata {
+   double delay;	/* Total delay, including setup and clock skew */
+   double trans;	/* Transition time at destination, used to find setup */
+   btptr backtrace;
+   ddataptr  next;
+} delaydata;
+
+// Linked list of connection pointers
+// (Much like delaydata, but without all the timing information)
+
+typedef struct _connlist *connlistptr;
+
+typedef struct _connlist {
+   connptr connection;
+   connlistptr next;
+} connlist;
+
+// Timing data of one connection in an additional process corner:  the
+// pin of the corner's library, the load of the net driven by the
+// instance in that library, and the pin's tables collapsed at that load
+// (made on first use;  see collapse_connection()).
+
+typedef struct _cornerconn {
+   pinptr   pin;		/* Pin in the corner library (NULL for outputs) */
+   double   loadr;		/* Load on the instance output, rising */
+   double   loadf;		/* Load on the instance output, falling */
+   double   **vectors;		/* Vectors at load condition (see vecpool_get()) */
+} cornerconn;
+
+// An additional process corner, timed on the netlist read with the first
+// liberty file.  Only the library and the timing data of each connection
+// (indexed as the nodes of the timing graph) are kept per corner.  The
+// first library's corner is a NULL corner pointer;  its timing data is
+// kept in the connection records themselves.
+
+typedef struct _corner {
+   char	      *name;		/* Liberty file of the corner */
+   lutable    *tables;
+   cell	      *cells;
+   cornerconn *conns;		/* Timing data of each connection */
+} corner;
+
+// Pin used for the timing of connection "conn" in corner "cn"
+#define CORNER_PIN(cn, conn) \
+	((cn) ? (cn)->conns[(conn)->index].pin : (conn)->refpin)
+
+// Hash table used to look up cells, pins, and nets by name while reading
+// the liberty and verilog files.  Each entry may have a "scope" pointer
+// that is part of the key, so that pins can be looked up by cell and
+// name in a single table.  Names are not copied, so the table must not
+// outlive the records that own the names.
+
+typedef struct _hashent *hashentptr;
+
+typedef struct _hashent {
+   char	      *name;
+   void	      *scope;	/* Additional key (e.g., parent cell of a pin) */
+   void	      *ptr;	/* Record being looked up */
+   hashentptr next;
+} hashent;
+
+typedef struct _hashtable {
+   int	      size;	/* Number of bins (always a power of 2) */
+   int	      count;	/* Number of entries */
+   char	      nocase;	/* 1 if names are case-insensitive */
+   hashentptr *bins;
+} hashtable;
+
+// Region allocator for the backtrace and delay records of one analysis
+// pass.  Records are carved out of large blocks and are never freed
+// individually;  backtraces share their common prefixes, and the whole
+// region is released at once when the pass is done.
+
+#define ARENA_BLOCK_SIZE	65536
+
+typedef struct _arenablock *arenablockptr;
+
+typedef struct _arenablock {
+   arenablockptr next;	/* Previously filled block */
+   size_t  size;	/* Size of the data area */
+   size_t  used;	/* Bytes of the data area in use */
+} arenablock;		/* Followed by the data area */
+
+typedef struct _arena {
+   arenablockptr blocks;	/* Current block first */
+   arenablockptr spare;		/* Released blocks kept for reuse */
+} arena;
+
+// Position in an arena, to which it can be rolled back
+
+typedef struct _arenamark {
+   arenablockptr block;
+   size_t  used;
+} arenamark;
+
+// Pool of the delay and transition tables of input pins collapsed to
+// vectors at a load.  The vectors depend only on the pin and the load,
+// so all connections with the same pin and load (as in wide datapaths)
+// share them.  Vectors are made when a connection is first timed, and
+// are kept until the program exits.  The pool is an open-addressed hash
+// table keyed by pin and load;  the vectors are kept in an arena, along
+// with the array of the four vectors of each entry, which is what each
+// connection points to.
+
+#define VECPOOL_INIT_SIZE	1024
+
+typedef struct _vecent {
+   pinptr     pin;		/* NULL for an empty slot */
+   double     loadr;		/* Load for rising output */
+   double     loadf;		/* Load for falling output */
+   double     **vector;	/* Prop delay rise and fall, transition rise and fall */
+} vecent;
+
+typedef struct _vecpool {
+   int	      size;	/* Number of slots (always a power of 2) */
+   int	      count;	/* Number of slots in use */
+   vecent     *slots;
+   arena      store;	/* Storage for the vectors */
+   pthread_mutex_t lock;
+} vecpool;
+
+// The collapsed vectors of a connection are set by whichever search
+// first times it (see collapse_connection()) while other searches may
+// be reading them, so they are set with a release store and read with
+// an acquire load, which also orders the vector contents.
+
+#define VECTOR_SET(field, value)  __atomic_store_n(&(field), (value), __ATOMIC_RELEASE)
+#define VECTOR_GET(field)	  __atomic_load_n(&(field), __ATOMIC_ACQUIRE)
+
+// Levelized timing graph.  Every receiver connection (instance input
+// pin or module output) is a node.  Gate input pins propagate to each
+// receiver on the gate's output net.  Register inputs and module outputs
+// are path endpoints and do not propagate.  Module inputs are numbered
+// after all of the receivers, so that every connection has an index.
+//
+// The fanout of each connection is kept in compressed sparse row form:
+// the arcs out of node n are arcs[arcstart[n]] to arcs[arcstart[n + 1] - 1].
+// Arcs that close combinational loops are removed (see find_graph_loops()),
+// so the propagating nodes form a directed acyclic graph.
+// Instance pins (including register inputs, which are followed only from
+// a launch point) fan out to the receivers on the instance's output net,
+// and module inputs to the receivers on their own net.
+
+typedef struct _tgraph {
+   int	   numnodes;	/* Number of receiver connections */
+   int	   numconns;	/* Number of connections, including module inputs */
+   connptr *nodes;	/* Node index to connection record */
+   int	   *arcstart;	/* Index of the first arc of each node */
+   int	   *arcs;	/* Destination node of each arc */
+   int	   *instart;	/* Index of the first fanin arc of each receiver */
+   int	   *inarcs;	/* Source node of each fanin arc */
+   int	   numorder;	/* Number of propagating (gate input) nodes */
+   int	   *order;	/* Propagating nodes in topological order */
+   int	   *pos;	/* Position of each node in "order" */
+   int	   numsccs;	/* Number of combinational loops (strongly connected components) */
+   int	   numloops;	/* Number of arcs removed to break the loops */
+   int	   *loopfrom;	/* Source node of each arc removed */
+   int	   *loopto;	/* Destination node of each arc removed */
+} tgraph;
+
+// Arrival record for one edge direction at one node of the timing graph,
+// used by the levelized search.
+
+typedef struct _arrival {
+   double  delay;	/* Arrival time, less the launch clock skew */
+   double  trans;	/* Transition time at this point */
+   int	   pred;	/* Previous node in the path (-1 if launch point) */
+   short   preddir;	/* Edge direction at the previous node */
+   short   predslot;	/* Arrival slot at the previous node */
+   int	   launch;	/* Index of launch point (-1 if not reached) */
+   btptr   bt;		/* Backtrace record, once generated */
+} arrival;
+
+// Clock arrival at one connection of the clock network, measured from
+// the clock sources (module inputs and flop outputs), for each analysis
+// (indexed by MINIMUM_TIME or MAXIMUM_TIME) and edge direction.
+
+typedef struct _clocknode {
+   double  delay[2][2];	/* Arrival time, by analysis and by direction - 1 */
+   double  trans[2][2];	/* Transition time, indexed likewise */
+} clocknode;
+
+// Clock arrivals of a design in one process corner.  These are found
+// once, in a single pass over the clock network, and looked up for each
+// launch point and path endpoint (see find_clock_latencies()).
+
+typedef struct _clocktree {
+   int	     *index;	/* Clock node of each graph node, or -1 */
+   int	     numindex;	/* Number of graph nodes */
+   clocknode *nodes;
+   int	     numnodes;
+   int	     maxnodes;
+   char	     valid;	/* 0 if the arrivals must be found again */
+} clocktree;
+
+// Launch point information for the levelized search
+
+typedef struct _launch {
+   connptr conn;	/* Clock pin of flop, or module input */
+   short   dir;		/* Edge direction at launch */
+   double  trans;	/* Transition time at launch */
+   btptr   clocklist;	/* Sources of the clock at the launch point */
+   btptr   source;	/* Clock source record with transition and skew */
+   btptr   bt;		/* Backtrace record for the launch point */
+} launch;
+
+// Result of the levelized search, kept so that it can be updated
+// incrementally after changes to the design.  Each node has "depth"
+// arrival slots for each edge direction, holding the worst arrivals
+// in order, so that up to "depth" paths can be traced to an endpoint.
+
+typedef struct _levelstate {
+   corner  *corner;	/* Process corner timed */
+   clocktree *clocks;	/* Clock arrivals in that corner */
+   launch  *launches;
+   int	   numlaunch;
+   int	   *launchidx;	/* Launch point index of each connection, or -1 */
+   arrival *arrivals;	/* 2 * depth per node (rising, then falling) */
+   int	   depth;	/* Number of arrival slots per node and direction */
+   char	   valid;	/* 0 if the search must be run again */
+   char	   merged;	/* 1 if merged from clock domains (see find_clock_domains()) */
+} levelstate;
+
+// First arrival slot of a node and edge direction
+#define NODE_ARRIVALS(lstate, node, dir) \
+	((lstate)->arrivals + (2 * (node) + (dir) - 1) * (lstate)->depth)
+
+// Rank of a path among those to the same endpoint.  Paths that the
+// clock at the endpoint captures come first, as only those are checked
+// for setup or hold time, and then the worst by the delay of the whole
+// path (see capture_path_delay()).
+
+typedef struct _pathrank {
+   double  delay;	/* Delay including clock skew and setup or hold time */
+   char	   captured;	/* 1 if captured by the clock at the endpoint */
+} pathrank;
+
+// One clock domain of the launch points at register clocks, for the
+// levelized search.  Launch points are in the same domain when their
+// clocks have a source in common, and each domain is swept on its own
+// over the fanout cone of its launch points.  A merged result then holds
+// only the arrivals at the endpoints, with their backtraces already made.
+
+typedef struct _partition {
+   int	   id;		/* Domain number */
+   int	   *domain;	/* Domain of each launch point (shared by all domains) */
+   int	   *nodes;	/* Nodes of the cone, the propagating nodes first */
+   int	   numnodes;
+   int	   numorder;	/* Number of propagating nodes, in topological order */
+   arrival *ends[2];	/* 2 * depth per endpoint of the cone, by analysis */
+} partition;
+
+// Search over all clock domains, shared by the domain threads
+
+typedef struct _domainsearch {
+   tgraph    *graph;
+   corner    *corner;
+   clocktree *clocks;	/* Clock arrivals in that corner */
+   connlistptr clockedlist;
+   partition *parts;
+   int	     numparts;
+   int	     next;	/* Next domain to be swept */
+   pthread_mutex_t lock;
+   levelstate **lstate;	/* Merged result, by analysis */
+   char	     analyses;	/* Analyses searched (see ANALYSIS()) */
+   int	     depth;
+} domainsearch;
+
+// Argument passed to each domain thread
+
+typedef struct _domainthread {
+   domainsearch *search;
+   arena     pool[2];	/* Endpoint backtraces, by analysis */
+} domainthread;
+
+// Required times and slack of every connection of the timing graph,
+// found by a backward pass from the path endpoints over the arrivals of
+// the levelized search (see build_slack_map()).  Slack is positive when
+// the timing is met:  the required time less the arrival time for
+// maximum delay (setup), and the arrival time less the required time for
+// minimum delay (hold).  A connection that no path reaches, or from
+// which no endpoint is reached, has slack SLACK_NONE.
+
+typedef struct _slackmap {
+   int	   numconns;	/* Number of connections, as in the timing graph */
+   double  *arrival;	/* Worst arrival time (see SLACK_INDEX()) */
+   double  *required;	/* Required time, indexed likewise */
+   double  *slack;	/* Worst slack of each connection, by analysis */
+   double  period;	/* Clock period of the setup checks */
+   char	   valid;	/* 0 if the map must be made again */
+} slackmap;
+
+#define SLACK_NONE	HUGE_VAL
+
+// Arrival and required time of a connection, analysis and edge direction
+#define SLACK_INDEX(conn, minmax, dir)	(4 * (conn) + 2 * (minmax) + (dir) - 1)
+
+// Scratch space for the depth-first path search from one launch point.
+// Each search thread has its own, indexed by connection.
+
+// The tags, metrics, path records and path counts are kept separately
+// for each analysis (indexed by MINIMUM_TIME or MAXIMUM_TIME), as both
+// may be searched together.
+
+// Search state of one connection, for each analysis.  The state of
+// both analyses is kept together, as the combined search consults both
+// at each connection.
+
+// Arrival searched through a connection, kept by PRUNE_PARETO.  Times
+// are multiplied by TIME_SIGN, so that greater is worse.
+
+typedef struct _paretopt *paretoptr;
+
+typedef struct _paretopt {
+   paretoptr next;
+   double   delay;
+   double   trans;
+   short    dir;
+} paretopt;
+
+typedef struct _searchnode {
+   ddataptr tag[2];	/* Path recorded at an endpoint */
+   paretoptr front[2];	/* Arrivals not dominated by another (PRUNE_PARETO) */
+   double   metric[2];	/* Delay metrics at the connection (times TIME_SIGN) */
+   unsigned int visit;	/* Search in which the connection was last visited */
+} searchnode;
+
+// Path search counters, for profiling (see --profile)
+
+typedef struct _searchcount {
+   long	    visited;	/* Connections visited */
+   long	    pruned;	/* Paths pruned by the delay metric or front */
+   long	    loops;	/* Paths truncated at a logic loop */
+   long	    records;	/* Backtrace records allocated */
+} searchcount;
+
+typedef struct _searchctx {
+   tgraph   *graph;
+   corner   *corner;
+   searchnode *nodes;	/* Search state of each connection */
+   unsigned int epoch;	/* Number of the current search */
+   arena    scratch;	/* Backtrace and delay records during the search */
+   arena    fronts;	/* Pareto front records during the search */
+   paretoptr freepts;	/* Pareto front records removed from a front */
+   arena    pool[2];	/* Backtrace and delay records of the paths found */
+   int	    recorded;	/* Number of times a path has been recorded */
+   int	    found[2];	/* Number of paths found from the launch point */
+   searchcount counts;
+} searchctx;
+
+// Range of launch points assigned to one search thread.  The thread
+// takes work from the front of its range;  idle threads steal work from
+// the back of other threads' ranges.
+
+typedef struct _workrange {
+   pthread_mutex_t lock;
+   int	   next;	/* Next launch point to take from the front */
+   int	   last;	/* One past the last launch point in the range */
+} workrange;
+
+// Path search over all launch points, shared by the search threads
+
+typedef struct _pathsearch {
+   tgraph    *graph;
+   corner    *corner;
+   clocktree *clocks;	/* Clock arrivals in that corner */
+   launch    *launches[2];	/* Launch point records, per analysis */
+   ddataptr  *results[2];	/* Paths found from each launch point */
+   int	     *numfound[2];	/* Number of paths found from each launch point */
+   int	     numlaunch;
+   char	     analyses;	/* Analyses searched (see ANALYSIS()) */
+   workrange *ranges;	/* Launch points assigned to each thread */
+   int	     numthreads;
+} pathsearch;
+
+// Argument passed to each search thread
+
+typedef struct _searchthread {
+   pathsearch *search;
+   searchctx  *ctx;	/* Scratch space, kept until the results are merged */
+   int	      id;	/* Thread number, and index into search->ranges */
+} searchthread;
+
+// Paths found in a design, sorted from longest to shortest delay
+
+typedef struct _pathset {
+   arena    pool;	/* Backtrace and delay records */
+   ddataptr *paths;
+   int	    numpaths;
+   char	    valid;	/* 0 if the paths must be found again */
+   char	    reported;	/* 1 once the number of paths has been reported */
+} pathset;
+
+// A design loaded for analysis.  The path sets are indexed by launch
+// point type (0 for register clocks, 2 for module inputs) plus 1 for
+// minimum delay paths.  This is the vesta_design of the C interface
+// (see vesta.h).
+
+typedef struct _design {
+   lutable     *tables;
+   cell	       *cells;
+   instptr     instlist;
+   netptr      netlist;
+   connptr     inputlist;
+   connptr     outputlist;
+   connlistptr clockconnlist;	/* Launch points at register clocks */
+   connlistptr inputconnlist;	/* Launch points at module inputs */
+   tgraph      *graph;
+   corner      *corner;		/* Process corner timed (NULL for the first) */
+   double      period;		/* Clock period, in ps (0 if not given) */
+   double      outload;		/* Load on module outputs, in fF */
+   pathset     paths[4];
+   levelstate  levels[4];	/* Levelized search results, indexed as "paths" */
+   clocktree   clocks;		/* Clock arrivals at the register clocks */
+   slackmap    slacks;		/* Required times and slack of each connection */
+   char	       incremental;	/* Keep "levels" for incremental updates */
+   connptr     *changed;	/* Receivers with changes not yet timed */
+   int	       numchanged;
+   int	       maxchanged;
+   char	       relink;		/* Connectivity changed;  rebuild the graph */
+   corner      **corners;	/* Process corners (the first is NULL) */
+   char	       **libnames;	/* Liberty file of each corner */
+   int	       numcorners;
+   hashtable   nets;		/* Nets by name (see index_design_names()) */
+   hashtable   insts;		/* Instances by name */
+   char	       indexed;		/* 1 once "nets" and "insts" are made */
+   char	       error[256];	/* Message of the last call that failed */
+   FILE	       *log;		/* Progress messages (see vesta_set_log()) */
+   char	       logset;		/* 1 once vesta_set_log() has been called */
+} design;
+
+// Timing of one process corner, run on its own thread.  Each corner has
+// its own design record, sharing the netlist and timing graph, and its
+// report is written to "out" until all corners are done.
+
+typedef struct _cornerjob {
+   design     des;
+   char	      *name;	/* Liberty file of the corner */
+   FILE	      *out;
+} cornerjob;
+
+// Resources used by one phase of a run, for profiling
+
+#define PROFILE_MAX_PHASES	16
+
+typedef struct _profphase {
+   char	    *name;
+   double   wall;	/* Elapsed time, in seconds */
+   double   cpu;	/* CPU time of all threads, in seconds */
+   long	    maxrss;	/* Peak resident set size at the end of the phase, in kB */
+   long	    heap;	/* Change in heap memory in use, in bytes */
+} profphase;
+
+typedef struct _profile {
+   char	       enabled;
+   profphase   phases[PROFILE_MAX_PHASES];
+   int	       numphases;
+   double      wallstart;	/* Start of the current phase */
+   double      cpustart;
+   long	       heapstart;
+   searchcount counts;		/* Totals of all path searches */
+   pthread_mutex_t lock;	/* Lock on "counts" */
+} profile;
+
+/* Global variables */
+
+static unsigned char verbose;	/* Level of debug output generated */
+static unsigned char pruning;	/* Path search pruning (PRUNE_DELAY, etc.) */
+static unsigned char levelized;	/* Levelized (graph-based) search mode */
+static int numthreads;		/* Number of path search threads */
+static int numreport;		/* Number of paths reported */
+static int perendpoint;		/* Paths reported per endpoint (0 = any) */
+static profile prof;		/* Per-phase profile (option --profile) */
+static hashtable loopbreaks;	/* Pins at which loops are broken (option -b) */
+static vecpool vectors;		/* Collapsed table vectors */
+
+/*--------------------------------------------------------------*/
+/* Parse a pin name.  Check if the cell has a pin of that name,	*/
+/* and if not, add the pin to the cell, giving it default	*/
+/* values.  The pin name may contain quotes, parentheses, or	*/
+/* negations ("!" or "'");  these should be ignored.		*/
+/*--------------------------------------------------------------*/
+
+static pinptr parse_pin(cellptr newcell, char *token, short sense_predef)
+{
+    pinptr newpin, lastpin;
+    char *pinname, *sptr;
+
+    // Advance to first legal pin name character
+
+    pinname = token;
+    while (isspace(*pinname) || (*pinname == '\'') || (*pinname == '\"') ||
+		(*pinname == '!') || (*pinname == '(') || (*pinname == ')'))
+	pinname++;
+
+    sptr = pinname;
+    while (*sptr != '\0') {
+	if (isspace(*sptr) || (*sptr == '\'') || (*sptr == '\"') ||
+		(*sptr == '!') || (*sptr == '(') || (*sptr == ')')) {
+	    *sptr = '\0';
+	    break;
+	}
+	sptr++;
+    }
+
+    // Check if pin was already defined
+
+    lastpin = NULL;
+    newpin = newcell->pins;
+    while (newpin) {
+	lastpin = newpin;
+	if (!strcmp(newpin->name, pinname))
+	    return newpin;
+	newpin = newpin->next;
+    }
+
+    // Pin was not defined, so create a new one and add it to the cell
+    // at the end of the cell's pin list.
+
+    newpin = (pin *)malloc(sizeof(pin));
+    newpin->name = strdup(pinname);
+    newpin->next = NULL;
+
+    if (lastpin != NULL)
+	lastpin->next = newpin;
+    else
+	newcell->pins = newpin;
+
+    newpin->type = INPUT;	// The default; modified later, if not an input
+    newpin->capr = 0.0;
+    newpin->capf = 0.0;
+    newpin->sense = sense_predef;  // Again, modified later if not true.
+    newpin->propdelr = NULL;
+    newpin->propdelf = NULL;
+    newpin->transr = NULL;
+    newpin->transf = NULL;
+    newpin->refcell = newcell;	// Create link back to cell
+    return newpin;
+}
+
+/*--------------------------------------------------------------*/
+/* Create a new net record					*/
+/*--------------------------------------------------------------*/
+
+static netptr create_net(netptr *netlist) {
+
+    netptr newnet;
+
+    newnet = (netptr)malloc(sizeof(net));
+    newnet->name = NULL;
+    newnet->next = *netlist;
+    *netlist = newnet;
+    newnet->driver = NULL;
+    newnet->fanout = 0;
+    newnet->receivers = NULL;
+    newnet->loadr = 0.0;
+    newnet->loadf = 0.0;
+    newnet->type = NET;
+
+    return newnet;
+}
+
+/*--------------------------------------------------------------*/
+/* Profiling (option --profile).  The run is divided into	*/
+/* phases;  profile_phase() ends the current phase, recording	*/
+/* the resources it used, and starts the next phase "name"	*/
+/* (or none, if "name" is NULL).  Nothing is recorded unless	*/
+/* prof.enabled is set.						*/
+/*--------------------------------------------------------------*/
+
+static double
+profile_wall()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.0E-9 * (double)ts.tv_nsec;
+}
+
+static double
+profile_cpu()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + 1.0E-9 * (double)ts.tv_nsec;
+}
+
+// Heap memory in use, in bytes, where the C library can report it
+
+static long
+profile_heap()
+{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+    struct mallinfo2 mi;
+
+    mi = mallinfo2();
+    return (long)(mi.uordblks + mi.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+static void
+profile_phase(char *name)
+{
+    profphase *phase;
+    struct rusage usage;
+
+    if (!prof.enabled) return;
+
+    // A negative start time means that no phase is open
+
+    if (prof.wallstart >= 0.0) {
+	phase = prof.phases + prof.numphases - 1;
+	getrusage(RUSAGE_SELF, &usage);
+	phase->wall = profile_wall() - prof.wallstart;
+	phase->cpu = profile_cpu() - prof.cpustart;
+	phase->maxrss = usage.ru_maxrss;
+	phase->heap = profile_heap() - prof.heapstart;
+	prof.wallstart = -1.0;
+    }
+    if ((name == NULL) || (prof.numphases == PROFILE_MAX_PHASES)) return;
+
+    phase = prof.phases + prof.numphases++;
+    phase->name = name;
+    prof.wallstart = profile_wall();
+    prof.cpustart = profile_cpu();
+    prof.heapstart = profile_heap();
+}
+
+// Add the counters of one path search to the totals
+
+static void
+profile_add_counts(searchcount *counts)
+{
+    if (!prof.enabled) return;
+
+    pthread_mutex_lock(&prof.lock);
+    prof.counts.visited += counts->visited;
+    prof.counts.pruned += counts->pruned;
+    prof.counts.loops += counts->loops;
+    prof.counts.records += counts->records;
+    pthread_mutex_unlock(&prof.lock);
+}
+
+/*--------------------------------------------------------------*/
+/* Print the profile of each phase to "out".			*/
+/*--------------------------------------------------------------*/
+
+static void
+profile_report(FILE *out)
+{
+    profphase *phase;
+    double wall = 0.0, cpu = 0.0;
+    int i;
+
+    fprintf(out, "\nProfile:\n");
+    fprintf(out, "   %-20s %10s %10s %12s %12s\n", "phase", "wall (s)", "cpu (s)",
+		"max RSS (kB)", "heap (kB)");
+    for (i = 0; i < prof.numphases; i++) {
+	phase = prof.phases + i;
+	fprintf(out, "   %-20s %10.3f %10.3f %12ld %12ld\n", phase->name,
+		phase->wall, phase->cpu, phase->maxrss, phase->heap / 1024);
+	wall += phase->wall;
+	cpu += phase->cpu;
+    }
+    fprintf(out, "   %-20s %10.3f %10.3f\n", "total", wall, cpu);
+    fprintf(out, "   Search:  %ld nodes visited, %ld pruned, %ld loops cut, "
+		"%ld path records\n", prof.counts.visited, prof.counts.pruned,
+		prof.counts.loops, prof.counts.records);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the profile to file "filename" in JSON format, for	*/
+/* comparison between runs.  Return 0 on success, -1 if the	*/
+/* file cannot be written.					*/
+/*--------------------------------------------------------------*/
+
+static int
+profile_write_json(char *filename)
+{
+    FILE *fout;
+    profphase *phase;
+    int i;
+
+    fout = fopen(filename, "w");
+    if (fout == NULL) {
+	fprintf(stderr, "Cannot open %s for writing\n", filename);
+	return -1;
+    }
+    fprintf(fout, "{\n  \"phases\": [\n");
+    for (i = 0; i < prof.numphases; i++) {
+	phase = prof.phases + i;
+	fprintf(fout, "    {\"name\": \"%s\", \"wall\": %.6f, \"cpu\": %.6f, "
+		"\"maxrss_kb\": %ld, \"heap_bytes\": %ld}%s\n", phase->name,
+		phase->wall, phase->cpu, phase->maxrss, phase->heap,
+		(i < prof.numphases - 1) ? "," : "");
+    }
+    fprintf(fout, "  ],\n  \"search\": {\"visited\": %ld, \"pruned\": %ld, "
+		"\"loops\": %ld, \"records\": %ld}\n}\n", prof.counts.visited,
+		prof.counts.pruned, prof.counts.loops, prof.counts.records);
+    fclose(fout);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Hash table routines.  The table starts with "size" bins	*/
+/* (rounded up to a power of 2) and doubles in size whenever	*/
+/* the average bin holds more than two entries, so that lookup	*/
+/* time stays constant as the table grows.			*/
+/*--------------------------------------------------------------*/
+
+static void
+hash_init(hashtable *table, int size, char nocase)
+{
+    table->size = 16;
+    while (table->size < size) table->size <<= 1;
+    table->count = 0;
+    table->nocase = nocase;
+    table->bins = (hashentptr *)calloc(table->size, sizeof(hashentptr));
+}
+
+static unsigned int
+hash_string(hashtable *table, char *name, void *scope)
+{
+    unsigned int hashval = 2166136261U;		// FNV-1a
+    unsigned char *cptr;
+
+    for (cptr = (unsigned char *)name; *cptr; cptr++) {
+	hashval ^= (table->nocase) ? (unsigned int)tolower(*cptr) : (unsigned int)*cptr;
+	hashval *= 16777619U;
+    }
+    hashval ^= (unsigned int)((size_t)scope >> 4);
+    hashval *= 16777619U;
+    return hashval & (table->size - 1);
+}
+
+static void *
+hash_lookup(hashtable *table, char *name, void *scope)
+{
+    hashentptr entry;
+
+    for (entry = table->bins[hash_string(table, name, scope)]; entry;
+		entry = entry->next) {
+	if (entry->scope != scope) continue;
+	if (table->nocase) {
+	    if (!strcasecmp(entry->name, name)) return entry->ptr;
+	}
+	else if (!strcmp(entry->name, name)) return entry->ptr;
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Add a record to the hash table.  If a record with the same	*/
+/* name and scope is already in the table, the new record	*/
+/* takes precedence over it.					*/
+/*--------------------------------------------------------------*/
+
+static void
+hash_insert(hashtable *table, char *name, void *scope, void *ptr)
+{
+    hashentptr entry, *oldbins;
+    unsigned int hashval;
+    int i, oldsize;
+
+    if (table->count >= (table->size << 1)) {
+	oldbins = table->bins;
+	oldsize = table->size;
+	table->size <<= 1;
+	table->bins = (hashentptr *)calloc(table->size, sizeof(hashentptr));
+	for (i = 0; i < oldsize; i++) {
+	    while ((entry = oldbins[i]) != NULL) {
+		oldbins[i] = entry->next;
+		hashval = hash_string(table, entry->name, entry->scope);
+		entry->next = table->bins[hashval];
+		table->bins[hashval] = entry;
+	    }
+	}
+	free(oldbins);
+    }
+
+    hashval = hash_string(table, name, scope);
+    entry = (hashentptr)malloc(sizeof(hashent));
+    entry->name = name;
+    entry->scope = scope;
+    entry->ptr = ptr;
+    entry->next = table->bins[hashval];
+    table->bins[hashval] = entry;
+    table->count++;
+}
+
+static void
+hash_free(hashtable *table)
+{
+    hashentptr entry;
+    int i;
+
+    for (i = 0; i < table->size; i++) {
+	while ((entry = table->bins[i]) != NULL) {
+	    table->bins[i] = entry->next;
+	    free(entry);
+	}
+    }
+    free(table->bins);
+    table->bins = NULL;
+    table->count = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Arena allocator routines.  Allocations are aligned for	*/
+/* doubles and pointers.					*/
+/*--------------------------------------------------------------*/
+
+static void
+arena_init(arena *pool)
+{
+    pool->blocks = NULL;
+    pool->spare = NULL;
+}
+
+static void *
+arena_alloc(arena *pool, size_t size)
+{
+    arenablockptr block;
+    size_t bsize;
+    void *ptr;
+
+    size = (size + sizeof(double) - 1) & ~(sizeof(double) - 1);
+    block = pool->blocks;
+    if ((block == NULL) || (block->used + size > block->size)) {
+	if ((pool->spare != NULL) && (size <= pool->spare->size)) {
+	    block = pool->spare;
+	    pool->spare = block->next;
+	}
+	else {
+	    bsize = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+	    block = (arenablockptr)malloc(sizeof(arenablock) + bsize);
+	    block->size = bsize;
+	}
+	block->used = 0;
+	block->next = pool->blocks;
+	pool->blocks = block;
+    }
+    ptr = (char *)block + sizeof(arenablock) + block->used;
+    block->used += size;
+    return ptr;
+}
+
+static arenamark
+arena_mark(arena *pool)
+{
+    arenamark mark;
+
+    mark.block = pool->blocks;
+    mark.used = (mark.block) ? mark.block->used : 0;
+    return mark;
+}
+
+/*--------------------------------------------------------------*/
+/* Release everything allocated from "pool" since "mark" was	*/
+/* taken.  The memory is kept for reuse by the same arena.	*/
+/*--------------------------------------------------------------*/
+
+static void
+arena_release(arena *pool, arenamark mark)
+{
+    arenablockptr block;
+
+    while (pool->blocks != mark.block) {
+	block = pool->blocks;
+	pool->blocks = block->next;
+	block->next = pool->spare;
+	pool->spare = block;
+    }
+    if (mark.block) mark.block->used = mark.used;
+}
+
+/*--------------------------------------------------------------*/
+/* Move all of the blocks in use by "src" into "dest", so that	*/
+/* they are released along with "dest".				*/
+/*--------------------------------------------------------------*/
+
+static void
+arena_merge(arena *dest, arena *src)
+{
+    arenablockptr block;
+
+    if (src->blocks != NULL) {
+	for (block = src->blocks; block->next; block = block->next);
+	if (dest->blocks != NULL) {
+	    block->next = dest->blocks->next;
+	    dest->blocks->next = src->blocks;
+	}
+	else
+	    dest->blocks = src->blocks;
+	src->blocks = NULL;
+    }
+}
+
+static void
+arena_free(arena *pool)
+{
+    arenablockptr block;
+
+    while (pool->blocks != NULL) {
+	block = pool->blocks;
+	pool->blocks = block->next;
+	free(block);
+    }
+    while (pool->spare != NULL) {
+	block = pool->spare;
+	pool->spare = block->next;
+	free(block);
+    }
+}
+
+/*----------------------------------------------------------------------*/
+/* Find the entries of the "size" index values in "index" (in		*/
+/* increasing order) that bound "x", or the two nearest entries, if	*/
+/* extrapolating.  Return the index of the upper entry.  Entries are	*/
+/* counted without branching on each comparison, so the search runs at	*/
+/* the same speed wherever "x" falls in the table.			*/
+/*----------------------------------------------------------------------*/
+
+static int table_bracket(double *index, int size, double x)
+{
+    int i, k;
+
+    i = 0;
+    for (k = 0; k < size; k++)
+	i += (index[k] <= x);
+
+    // "i" is now the position of the first entry greater than "x"
+    return (i == 0) ? 1 : ((i == size) ? size - 1 : i);
+}
+
+/*----------------------------------------------------------------------*/
+/* Interpolate or extrapolate a vector from a time vs. capacitance	*/
+/* lookup table.  The vector is written to "vector", which must have	*/
+/* room for tableptr->size1 values, and is returned.			*/
+/*----------------------------------------------------------------------*/
+
+static double *table_collapse(lutableptr tableptr, double load, double *vector)
+{
+    double cfrac, vlow, vhigh;
+    int i, j;
+
+    // If the table is 1-dimensional, then just return a copy of the table.
+    if (tableptr->size2 <= 1) {
+       for (i = 0; i < tableptr->size1; i++) {
+	  *(vector + i) = *(tableptr->values + i);
+       }
+       return vector;
+    }
+
+    // Find cap load index entries bounding  "load", or the two nearest
+    // entries, if extrapolating
+
+    j = table_bracket(tableptr->idx2.caps, tableptr->size2, load);
+
+    cfrac = (load - tableptr->idx2.caps[j - 1]) /
+			(tableptr->idx2.caps[j] - tableptr->idx2.caps[j - 1]);
+
+    for (i = 0; i < tableptr->size1; i++) {
+
+	// Interpolate value at cap load for each transition value
+
+	vlow = *(tableptr->values + i * tableptr->size2 + (j - 1));
+	vhigh = *(tableptr->values + i * tableptr->size2 + j);
+	*(vector + i) = vlow + (vhigh - vlow) * cfrac;
+    }
+    return vector;
+}
+
+/*----------------------------------------------------------------------*/
+/* Collapsed vector pool (see vecpool).  vecpool_get() returns the	*/
+/* vectors of the tables of pin "testpin" at loads "loadr" and "loadf",	*/
+/* collapsing the tables if no connection has used the pin at those	*/
+/* loads before.  The caller must hold the pool lock.			*/
+/*----------------------------------------------------------------------*/
+
+static void vecpool_init()
+{
+    vectors.size = VECPOOL_INIT_SIZE;
+    vectors.count = 0;
+    vectors.slots = (vecent *)calloc(vectors.size, sizeof(vecent));
+    arena_init(&vectors.store);
+    pthread_mutex_init(&vectors.lock, NULL);
+}
+
+static unsigned int vecpool_hash(pinptr testpin, double loadr, double loadf)
+{
+    unsigned long long bits, fbits;
+
+    memcpy(&bits, &loadr, sizeof(double));
+    memcpy(&fbits, &loadf, sizeof(double));
+    bits ^= (fbits << 1) ^ ((unsigned long long)(size_t)testpin >> 4);
+    bits *= 0x9E3779B97F4A7C15ULL;
+    return (unsigned int)(bits >> 32) & (vectors.size - 1);
+}
+
+static double *vecpool_collapse(lutableptr tableptr, double load)
+{
+    if (tableptr == NULL) return NULL;
+    return table_collapse(tableptr, load, (double *)arena_alloc(&vectors.store,
+		tableptr->size1 * sizeof(double)));
+}
+
+static vecent *vecpool_get(pinptr testpin, double loadr, double loadf)
+{
+    vecent *slot, *oldslots;
+    unsigned int h;
+    int i, oldsize;
+
+    h = vecpool_hash(testpin, loadr, loadf);
+    for (slot = vectors.slots + h; slot->pin != NULL;
+		slot = vectors.slots + (h = (h + 1) & (vectors.size - 1)))
+	if ((slot->pin == testpin) && (slot->loadr == loadr) && (slot->loadf == loadf))
+	    return slot;
+
+    // Not found:  grow the table if it is half full, then add the vectors
+
+    if (2 * (vectors.count + 1) > vectors.size) {
+	oldslots = vectors.slots;
+	oldsize = vectors.size;
+	vectors.size <<= 1;
+	vectors.slots = (vecent *)calloc(vectors.size, sizeof(vecent));
+	for (i = 0; i < oldsize; i++) {
+	    if (oldslots[i].pin == NULL) continue;
+	    h = vecpool_hash(oldslots[i].pin, oldslots[i].loadr, oldslots[i].loadf);
+	    while (vectors.slots[h].pin != NULL)
+		h = (h + 1) & (vectors.size - 1);
+	    vectors.slots[h] = oldslots[i];
+	}
+	free(oldslots);
+	h = vecpool_hash(testpin, loadr, loadf);
+	while (vectors.slots[h].pin != NULL)
+	    h = (h + 1) & (vectors.size - 1);
+	slot = vectors.slots + h;
+    }
+
+    slot->pin = testpin;
+    slot->loadr = loadr;
+    slot->loadf = loadf;
+    slot->vector = (double **)arena_alloc(&vectors.store, 4 * sizeof(double *));
+    slot->vector[0] = vecpool_collapse(testpin->propdelr, loadr);
+    slot->vector[1] = vecpool_collapse(testpin->propdelf, loadf);
+    slot->vector[2] = vecpool_collapse(testpin->transr, loadr);
+    slot->vector[3] = vecpool_collapse(testpin->transf, loadf);
+    vectors.count++;
+    return slot;
+}
+
+/*----------------------------------------------------------------------*/
+/* Interpolate/extrapolate a delay or transition value from a vector of	*/
+/* values at a known output load.  The original full 2D table contains	*/
+/* the transition time index values.					*/
+/*----------------------------------------------------------------------*/
+
+static double vector_get_value(lutableptr tableptr, double *vector, double trans)
+{
+    int i;
+    double tfrac, vlow, vhigh, value;
+
+    // Find time index entries bounding  "trans", or the two nearest
+    // entries, if extrapolating
+
+    i = table_bracket(tableptr->idx1.times, tableptr->size1, trans);
+
+    // Compute transition time as a fraction of the nearest table indexes
+    // for transition times
+
+    tfrac = (trans - tableptr->idx1.times[i - 1]) /
+		(tableptr->idx1.times[i] - tableptr->idx1.times[i - 1]);
+
+    // Interpolate value
+    vlow = *(vector + (i - 1));
+    vhigh = *(vector + i);
+    value = vlow + (vhigh - vlow) * tfrac;
+    return value;
+}
+
+/*----------------------------------------------------------------------*/
+/* Interpolate/extrapolate the rise and fall values of a pair of	*/
+/* vectors at the same transition time in one call, placing them in	*/
+/* values[0] and values[1].  A missing (NULL) vector gives the value	*/
+/* zero.  When the two tables share their index array (see		*/
+/* share_table_indexes()), the bounding entries are found once.  The	*/
+/* two interpolations are done together in SIMD registers where the	*/
+/* machine has them;  the arithmetic is the same as in			*/
+/* vector_get_value(), so the results are identical.			*/
+/*----------------------------------------------------------------------*/
+
+static void vector_get_pair(lutableptr rtable, double *rvector, lutableptr ftable,
+		double *fvector, double trans, double *values)
+{
+    double rfrac, ffrac;
+    double *index;
+    int i, j;
+
+    if ((rvector == NULL) || (fvector == NULL)) {
+	values[0] = (rvector) ? vector_get_value(rtable, rvector, trans) : 0.0;
+	values[1] = (fvector) ? vector_get_value(ftable, fvector, trans) : 0.0;
+	return;
+    }
+
+    index = rtable->idx1.times;
+    i = table_bracket(index, rtable->size1, trans);
+    rfrac = (trans - index[i - 1]) / (index[i] - index[i - 1]);
+
+    if (ftable->idx1.times == index) {
+	j = i;
+	ffrac = rfrac;
+    }
+    else {
+	index = ftable->idx1.times;
+	j = table_bracket(index, ftable->size1, trans);
+	ffrac = (trans - index[j - 1]) / (index[j] - index[j - 1]);
+    }
+
+#ifdef __SSE2__
+    {
+	__m128d vlow = _mm_set_pd(fvector[j - 1], rvector[i - 1]);
+	__m128d vhigh = _mm_set_pd(fvector[j], rvector[i]);
+	__m128d tfrac = _mm_set_pd(ffrac, rfrac);
+
+	_mm_storeu_pd(values, _mm_add_pd(vlow,
+		_mm_mul_pd(_mm_sub_pd(vhigh, vlow), tfrac)));
+    }
+#else
+    values[0] = rvector[i - 1] + (rvector[i] - rvector[i - 1]) * rfrac;
+    values[1] = fvector[j - 1] + (fvector[j] - fvector[j - 1]) * ffrac;
+#endif
+}
+
+/*----------------------------------------------------------------------*/
+/* Interpolate or extrapolate a value from a related time vs.		*/
+/* constrained time lookup table.					*/
+/*----------------------------------------------------------------------*/
+
+static double binomial_get_value(lutableptr tableptr, double rtrans, double ctrans)
+{
+    int i, j;
+    double rfrac, cfrac, vlow, vhigh, valuel, valueh, value;
+
+    /* Tables have been arranged such that idx1 is related time,	*/
+    /* idx2 is constrained time */
+
+    // Find time index entries bounding  "rtrans", or the two nearest
+    // entries, if extrapolating
+
+    i = table_bracket(tableptr->idx1.rel, tableptr->size1, rtrans);
+
+    // Compute transition time as a fraction of the nearest table indexes
+    // for transition times
+
+    rfrac = (rtrans - tableptr->idx1.rel[i - 1]) /
+		(tableptr->idx1.rel[i] - tableptr->idx1.rel[i - 1]);
+
+    // 1-dimensional computation, if this table is 1-dimensional
+
+    if (tableptr->size2 == 0) {
+	vlow = *(tableptr->values + (i - 1));
+	vhigh = *(tableptr->values + i);
+	value = vlow + (vhigh - vlow) * rfrac;
+	return value;
+    }
+
+    // Find cons index entries bounding  "ctrans", or the two nearest
+    // entries, if extrapolating
+
+    j = table_bracket(tableptr->idx2.cons, tableptr->size2, ctrans);
+
+    // Compute cons transition as a fraction of the nearest table indexes for cons
+
+    cfrac = (ctrans - tableptr->idx2.cons[j - 1]) /
+			(tableptr->idx2.cons[j] - tableptr->idx2.cons[j - 1]);
+
+    // Interpolate value at cons lower bound
+    vlow = *(tableptr->values + (i - 1) * tableptr->size2 + (j - 1));
+    vhigh = *(tableptr->values + i * tableptr->size2 + (j - 1));
+    valuel = vlow + (vhigh - vlow) * rfrac;
+
+    // Interpolate value at cons upper bound
+    vlow = *(tableptr->values + (i - 1) * tableptr->size2 + j);
+    vhigh = *(tableptr->values + i * tableptr->size2 + j);
+    valueh = vlow + (vhigh - vlow) * rfrac;
+
+    // Final interpolation (binomial interpolation)
+    value = valuel + (valueh - valuel) * cfrac;
+    return value;
+}
+
+/*----------------------------------------------------------------------*/
+/* Determine how the sense of a signal changes going from a gate's 	*/
+/* input to its output.  If the gate's input pin is positive unate	*/
+/* relative to the gate output, then the signal sense remains the same.	*/
+/* If it is negative unate, then the signal sense inverts.  If it is	*/
+/* non-unate, then the signal sense becomes non-unate, and we calculate	*/
+/* timing for both edges from that point forward, always accepting the	*/
+/* maximum time.							*/
+/*----------------------------------------------------------------------*/
+
+static short calc_dir(pinptr testpin, short dir)
+{
+    short outdir;
+
+    outdir = UNKNOWN;
+    if (testpin == NULL) return dir;
+
+    switch(dir) {
+	case RISING:
+	    if (testpin->sense == SENSE_POSITIVE)
+		outdir = RISING;	/* rising input, rising output */
+	    else if (testpin->sense == SENSE_NEGATIVE)
+		outdir = FALLING;	/* rising input, falling output */
+	    else
+		outdir = EITHER;	/* output can be rising or falling */
+	    break;
+	case FALLING:
+	    if (testpin->sense == SENSE_POSITIVE)
+		outdir = FALLING;	/* falling input, falling output */
+	    else if (testpin->sense == SENSE_NEGATIVE)
+		outdir = RISING;	/* falling input, rising output */
+	    else
+		outdir = EITHER;		/* output can be rising or falling */
+	    break;
+	case EITHER:
+	    outdir = EITHER;		/* output can be rising or falling */
+	    break;
+    }
+    return outdir;
+}
+
+/*----------------------------------------------------------------------*/
+/* Set the collapsed vectors of instance input connection "testconn"	*/
+/* in process corner "cn" (or of the connection record itself if "cn"	*/
+/* is NULL).  The vectors are taken from the pool at the load of the	*/
+/* net driven by the instance.  Searches running in parallel may time	*/
+/* the same connection at once, so the vectors are set with the pool	*/
+/* locked, and set again by any later caller with identical values.	*/
+/*----------------------------------------------------------------------*/
+
+static void collapse_connection(corner *cn, connptr testconn)
+{
+    pinptr testpin;
+    netptr loadnet;
+    cornerconn *cconn;
+    vecent *entry;
+
+    pthread_mutex_lock(&vectors.lock);
+    if (cn == NULL) {
+	testpin = testconn->refpin;
+	loadnet = testconn->refinst->out_connects->refnet;
+	entry = vecpool_get(testpin, loadnet->loadr, loadnet->loadf);
+	VECTOR_SET(testconn->vectors, entry->vector);
+    }
+    else {
+	cconn = cn->conns + testconn->index;
+	entry = vecpool_get(cconn->pin, cconn->loadr, cconn->loadf);
+	VECTOR_SET(cconn->vectors, entry->vector);
+    }
+    pthread_mutex_unlock(&vectors.lock);
+}
+
+/*----------------------------------------------------------------------*/
+/* Calculate the propagation delay from "testpin" to the output		*/
+/* of the gate to which "testpin" is an input.				*/
+/*									*/
+/* "sense" is a pointer to the sense at the input.  SENSE_POSITIVE	*/
+/* indicates a rising edge at the pin, SENSE_NEGATIVE indicates a	*/
+/* falling edge at the pin.  "sense" is updated to indicate if the	*/
+/* output transition is rising, falling, or unknown (SENSE_NONE).	*/
+/*									*/
+/* "loadnet" is a pointer to the net connected to the cell instance's	*/
+/* output pin.  Load values will be taken from this net, depending on	*/
+/* the sense of the output.						*/
+/*									*/
+/* "testpin" is the pin receiving the input signal, and the pin	record	*/
+/* containing the relevant timing tables.				*/
+/*									*/
+/* The tables and collapsed vectors are those of process corner "cn",	*/
+/* or of the connection record itself if "cn" is NULL.			*/
+/*----------------------------------------------------------------------*/
+
+static double calc_prop_delay(corner *cn, double trans, connptr testconn, short sense,
+		char minmax)
+{
+    pinptr testpin;
+    cornerconn *cconn;
+    double **vector;
+    double propdelay[2], propdelayr, propdelayf;
+
+    if (cn == NULL) {
+	testpin = testconn->refpin;
+	vector = VECTOR_GET(testconn->vectors);
+    }
+    else {
+	cconn = cn->conns + testconn->index;
+	testpin = cconn->pin;
+	vector = VECTOR_GET(cconn->vectors);
+    }
+    if (testpin == NULL) return 0.0;
+
+    if (vector == NULL) {
+	collapse_connection(cn, testconn);
+	vector = (cn) ? VECTOR_GET(cconn->vectors) : VECTOR_GET(testconn->vectors);
+    }
+
+    vector_get_pair(testpin->propdelr, (sense != SENSE_NEGATIVE) ?
+		vector[0] : NULL, testpin->propdelf,
+		(sense != SENSE_POSITIVE) ? vector[1] : NULL,
+		trans, propdelay);
+    propdelayr = propdelay[0];
+    propdelayf = propdelay[1];
+
+    if (sense == SENSE_POSITIVE) return propdelayr;
+    if (sense == SENSE_NEGATIVE) return propdelayf;
+
+    return TIME_WORST(minmax, propdelayr, propdelayf);
+}
+
+/*----------------------------------------------------------------------*/
+/* Calculate the transition time from "testpin" to the output		*/
+/* of the gate to which "testpin" is an input.	This is equivalent to	*/
+/* the propagation delay calculation routine above, apart from using	*/
+/* the lookup tables for transition time instead of propagation delay.	*/
+/*----------------------------------------------------------------------*/
+
+static double calc_transition(corner *cn, double trans, connptr testconn, short sense,
+		char minmax)
+{
+    pinptr testpin;
+    cornerconn *cconn;
+    double **vector;
+    double outtrans[2], transr, transf;
+
+    if (cn == NULL) {
+	testpin = testconn->refpin;
+	vector = VECTOR_GET(testconn->vectors);
+    }
+    else {
+	cconn = cn->conns + testconn->index;
+	testpin = cconn->pin;
+	vector = VECTOR_GET(cconn->vectors);
+    }
+    if (testpin == NULL) return 0.0;
+
+    if (vector == NULL) {
+	collapse_connection(cn, testconn);
+	vector = (cn) ? VECTOR_GET(cconn->vectors) : VECTOR_GET(testconn->vectors);
+    }
+
+    vector_get_pair(testpin->transr, (sense != SENSE_NEGATIVE) ?
+		vector[2] : NULL, testpin->transf,
+		(sense != SENSE_POSITIVE) ? vector[3] : NULL,
+		trans, outtrans);
+    transr = outtrans[0];
+    transf = outtrans[1];
+
+    if (sense == SENSE_POSITIVE) return transr;
+    if (sense == SENSE_NEGATIVE) return transf;
+
+    return TIME_WORST(minmax, transr, transf);
+}
+
+/*----------------------------------------------------------------------*/
+/* Calculate the hold time for a flop input "testpin" relative to the	*/
+/* flop clock, where "trans" is the transition time of the signal at	*/
+/* "testpin", and "clktrans" is the transition time of the clock	*/
+/* signal at the clock pin.  "sense" is the sense of the input signal	*/
+/* at "testpin".							*/
+/*----------------------------------------------------------------------*/
+
+static double calc_hold_time(double trans, pinptr testpin, double clktrans, short sense,
+		char minmax)
+{
+    double holdr, holdf;
+
+    if (testpin == NULL) return 0.0;
+
+    holdr = 0.0;
+    holdf = 0.0;
+
+    if (sense != SENSE_NEGATIVE) {
+	if (testpin->transr)
+	    holdr = binomial_get_value(testpin->transr, trans, clktrans);
+	if (sense == SENSE_POSITIVE) return holdr;
+    }
+
+    if (sense != SENSE_POSITIVE) {
+	if (testpin->transf)
+	    holdf = binomial_get_value(testpin->transf, trans, clktrans);
+	if (sense == SENSE_NEGATIVE) return holdf;
+    }
+
+    return TIME_WORST(minmax, holdr, holdf);
+}
+
+/*----------------------------------------------------------------------*/
+/* Calculate the setup time for a flop input "testpin" relative to the	*/
+/* flop clock, where "trans" is the transition time of the signal at	*/
+/* "testpin", and "clktrans" is the transition time of the clock	*/
+/* signal at the clock pin.  "sense" is the sense of the input signal	*/
+/* at "testpin".							*/
+/*----------------------------------------------------------------------*/
+
+static double calc_setup_time(double trans, pinptr testpin, double clktrans, short sense,
+		char minmax)
+{
+    double setupr, setupf;
+
+    if (testpin == NULL) return 0.0;
+
+    setupr = 0.0;
+    setupf = 0.0;
+
+    if (sense != SENSE_NEGATIVE) {
+	if (testpin->propdelr)
+	    setupr = binomial_get_value(testpin->propdelr, trans, clktrans);
+	if (sense == SENSE_POSITIVE) return setupr;
+    }
+
+    if (sense != SENSE_POSITIVE) {
+	if (testpin->propdelf)
+	    setupf = binomial_get_value(testpin->propdelf, trans, clktrans);
+	if (sense == SENSE_NEGATIVE) return setupf;
+    }
+
+    return TIME_WORST(minmax, setupr, setupf);
+}
+
+/*--------------------------------------------------------------*/
+/* Find the path from a clock back to all inputs or flop	*/
+/* outputs.  This list will be used to find nodes that are	*/
+/* common to other clocks.					*/
+/*--------------------------------------------------------------*/
+
+static void
+find_clock_source(connptr testlink, btptr *clocklist, short dir)
+{
+    netptr clknet;
+    connptr driver, iinput;
+    instptr iupstream;
+    btptr newclock;
+    short newdir;
+
+    /* Add this connection record to clocklist */
+
+    newclock = (btptr)malloc(sizeof(btdata));
+    newclock->delay = 0.0;
+    newclock->trans = 0.0;
+    newclock->dir = dir;
+    newclock->receiver = testlink;
+    newclock->next = *clocklist;
+    *clocklist = newclock;
+
+    clknet = testlink->refnet;
+    driver = clknet->driver;
+    if (driver == NULL) return;			/* Reached a module input */
+    iupstream = driver->refinst;
+
+    if (iupstream == NULL) return;		/* Not supposed to happen? */
+    if (driver->refpin->type & DFFOUT) return;	/* Reached a flop output */
+
+    for (iinput = iupstream->in_connects; iinput; iinput = iinput->next) {
+	newdir = calc_dir(iinput->refpin, dir);
+	find_clock_source(iinput, clocklist, newdir);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Find a net that is common to both "clocklist" and		*/
+/* "clock2list".  If one exists, return a pointer to the	*/
+/* connection.							*/
+/*--------------------------------------------------------------*/
+
+static netptr find_common_clock(btptr clocklist, btptr clock2list)
+{
+    btptr srch1ptr, srch2ptr;
+
+    for (srch1ptr = clocklist; srch1ptr; srch1ptr = srch1ptr->next)
+        for (srch2ptr = clock2list; srch2ptr; srch2ptr = srch2ptr->next)
+	    if (srch1ptr->receiver->refnet == srch2ptr->receiver->refnet)
+		return srch1ptr->receiver->refnet;
+
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Return 1 if an arrival of edge direction "dir" at a		*/
+/* connection, with delay "delay" and transition time "trans"	*/
+/* (both multiplied by TIME_SIGN), is dominated by an arrival	*/
+/* in "front":  that is, if an arrival of the same direction	*/
+/* has both a delay and a transition time at least as bad.	*/
+/* Where the delay and transition tables are monotonic, every	*/
+/* path from a dominated arrival is no worse than the same path	*/
+/* from the arrival dominating it, which has been searched	*/
+/* already, so the dominated arrival need not be searched.	*/
+/*--------------------------------------------------------------*/
+
+static int pareto_dominated(paretoptr front, short dir, double delay, double trans)
+{
+    paretoptr point;
+
+    for (point = front; point; point = point->next)
+	if ((point->dir == dir) && (point->delay >= delay) && (point->trans >= trans))
+	    return 1;
+
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Add an arrival (see pareto_dominated()) that has been	*/
+/* searched to the front "*frontptr", removing the arrivals it	*/
+/* dominates.  The arrival is not added if the front already	*/
+/* holds PARETO_MAX arrivals.  The records are allocated from	*/
+/* ctx->fronts, and those removed are kept in ctx->freepts for	*/
+/* reuse.							*/
+/*--------------------------------------------------------------*/
+
+static void pareto_insert(searchctx *ctx, paretoptr *frontptr, short dir,
+		double delay, double trans)
+{
+    paretoptr point, *pptr;
+    int count;
+
+    count = 0;
+    pptr = frontptr;
+    while ((point = *pptr) != NULL) {
+	if ((point->dir == dir) && (point->delay <= delay) && (point->trans <= trans)) {
+	    *pptr = point->next;
+	    point->next = ctx->freepts;
+	    ctx->freepts = point;
+	}
+	else {
+	    pptr = &point->next;
+	    count++;
+	}
+    }
+    if (count >= PARETO_MAX) return;
+
+    if (ctx->freepts != NULL) {
+	point = ctx->freepts;
+	ctx->freepts = point->next;
+    }
+    else
+	point = (paretoptr)arena_alloc(&ctx->fronts, sizeof(paretopt));
+    point->delay = delay;
+    point->trans = trans;
+    point->dir = dir;
+    point->next = *frontptr;
+    *frontptr = point;
+}
+
+/*--------------------------------------------------------------*/
+/* Determine the delay from input to output through a gate	*/
+/*								*/
+/* This is a recursive routine, continuing to find all delays	*/
+/* through the circuit until it reaches a terminal or flop	*/
+/* input, stopping on all terminal points found in the path.	*/
+/*								*/
+/* The routine keeps a running record of the path followed from	*/
+/* the source, as a character string.  When a terminal is found, the path and delay are	*/
+/* saved and added to "delaylist".  After the recursive search,	*/
+/* "delaylist" contains a list of all paths starting from the	*/
+/* original connection "receiver" and ending on a clock or an	*/
+/* output pin.  Where multiple paths exist between source and	*/
+/* destination, only the path with the longest delay is kept.	*/
+/*								*/
+/* The minimum and maximum delay analyses may be searched	*/
+/* together, sharing the traversal.  "analyses" holds the	*/
+/* ANALYSIS() bit of each one still following this path, and	*/
+/* "delay", "trans", "backtrace" and "delaylist" have an entry	*/
+/* for each (indexed by MINIMUM_TIME or MAXIMUM_TIME).  Each	*/
+/* analysis drops out of the path where its own search would	*/
+/* have stopped, so the paths found are the same as those of	*/
+/* separate searches.  The number of new paths recorded is	*/
+/* added to ctx->found.						*/
+/*--------------------------------------------------------------*/
+
+static void find_path_delay(searchctx *ctx, int dir, double *delay, double *trans,
+		connptr receiver, btptr *backtrace, ddataptr *delaylist, char analyses) {
+
+    pinptr   testpin;
+    tgraph   *graph;
+    searchnode *snode;
+    btptr    newbtdata[2];
+    ddataptr testddata, newddata;
+    arenamark mark;
+    double   newdelayr[2], newdelayf[2], newtransr[2], newtransf[2];
+    short    outdir;
+    int      minmax, first, last;
+    int	     i, node, recorded;
+
+    node = receiver->index;
+    testpin = receiver->refpin;
+
+    // The tags and metrics of a connection not yet visited in this
+    // search are left over from an earlier search, and are reset here.
+
+    ctx->counts.visited++;
+    snode = ctx->nodes + node;
+    if (snode->visit != ctx->epoch) {
+	snode->visit = ctx->epoch;
+	snode->tag[MINIMUM_TIME] = NULL;
+	snode->tag[MAXIMUM_TIME] = NULL;
+	snode->metric[MINIMUM_TIME] = -1E50;
+	snode->metric[MAXIMUM_TIME] = -1.0;
+	snode->front[MINIMUM_TIME] = NULL;
+	snode->front[MAXIMUM_TIME] = NULL;
+    }
+
+    first = (analyses & ANALYSIS(MINIMUM_TIME)) ? MINIMUM_TIME : MAXIMUM_TIME;
+    last = (analyses & ANALYSIS(MAXIMUM_TIME)) ? MAXIMUM_TIME : MINIMUM_TIME;
+    for (minmax = first; minmax <= last; minmax++) {
+
+	// Prevent exhaustive search by stopping on a metric.  Note that the
+	// nonlinear table-based delay data requires an exhaustive search;
+	// generally, the tables can be assumed to be monotonic, in which case
+	// we can stop if the delay is less than the greatest delay recorded
+	// at this point AND the transition time is less than the transition
+	// time recorded along with that delay.  A more relaxed metric is to
+	// use the delay plus the transition time, and an even more relaxed
+	// metric is to use only the delay.  Any relaxing of the metric
+	// implies that the final result may not be the absolute maximum delay,
+	// although it will typically vary by less than an average gate delay.
+	// The metric is kept multiplied by TIME_SIGN(), so the same test
+	// serves both analyses.  With PRUNE_PARETO, the exact metric is
+	// used, with the delay and transition time of each arrival not
+	// dominated by another kept in a front (see pareto_dominated()).
+
+	if (pruning == PRUNE_DELAY) {
+	    if (TIME_SIGN(minmax) * delay[minmax] <= snode->metric[minmax]) {
+		analyses &= ~ANALYSIS(minmax);
+		ctx->counts.pruned++;
+	    }
+	}
+	else if (pruning == PRUNE_PARETO) {
+	    if (pareto_dominated(snode->front[minmax], dir,
+			TIME_SIGN(minmax) * delay[minmax],
+			TIME_SIGN(minmax) * trans[minmax])) {
+		analyses &= ~ANALYSIS(minmax);
+		ctx->counts.pruned++;
+	    }
+	}
+    }
+    if (analyses == 0) return;
+
+    // From here on, "first" and "last" bound the analyses still active
+    // (which, as there are only two, are all those in between).
+
+    first = (analyses & ANALYSIS(MINIMUM_TIME)) ? MINIMUM_TIME : MAXIMUM_TIME;
+    last = (analyses & ANALYSIS(MAXIMUM_TIME)) ? MAXIMUM_TIME : MINIMUM_TIME;
+
+    // Record this position and delay/transition information.  If no
+    // path gets recorded through this point, then everything allocated
+    // from here on is discarded on return.
+
+    mark = arena_mark(&ctx->scratch);
+    recorded = ctx->recorded;
+
+    for (minmax = first; minmax <= last; minmax++) {
+	newbtdata[minmax] = (btptr)arena_alloc(&ctx->scratch, sizeof(btdata));
+	ctx->counts.records++;
+	newbtdata[minmax]->delay = delay[minmax];
+	newbtdata[minmax]->trans = trans[minmax];
+	newbtdata[minmax]->dir = dir;
+	newbtdata[minmax]->receiver = receiver;
+	newbtdata[minmax]->next = backtrace[minmax];
+    }
+
+    // Stop when we hit a module output pin or any flop/latch input.
+    // We must allow the routine to pass through the 1st register clock (on the first
+    // time through, the backtrace is NULL).
+
+    if ((backtrace[last] == NULL) || (testpin && ((testpin->type & REGISTER_IN) == 0))) {
+
+	// Compute delay from gate input to output
+
+	outdir = calc_dir(testpin, dir);
+	for (minmax = first; minmax <= last; minmax++) {
+	    if (outdir & RISING) {
+		newdelayr[minmax] = delay[minmax] + calc_prop_delay(ctx->corner,
+			trans[minmax], receiver, RISING, minmax);
+		newtransr[minmax] = calc_transition(ctx->corner, trans[minmax],
+			receiver, RISING, minmax);
+	    }
+	    if (outdir & FALLING) {
+		newdelayf[minmax] = delay[minmax] + calc_prop_delay(ctx->corner,
+			trans[minmax], receiver, FALLING, minmax);
+		newtransf[minmax] = calc_transition(ctx->corner, trans[minmax],
+			receiver, FALLING, minmax);
+	    }
+	}
+
+	graph = ctx->graph;
+	for (i = graph->arcstart[node]; i < graph->arcstart[node + 1]; i++) {
+	    if (outdir & RISING)
+		find_path_delay(ctx, RISING, newdelayr, newtransr,
+			graph->nodes[graph->arcs[i]], newbtdata, delaylist, analyses);
+	    if (outdir & FALLING)
+		find_path_delay(ctx, FALLING, newdelayf, newtransf,
+			graph->nodes[graph->arcs[i]], newbtdata, delaylist, analyses);
+	}
+    }
+    else for (minmax = first; minmax <= last; minmax++) {
+
+	/* Is receiver already in delaylist? */
+	if (snode->tag[minmax] != NULL) {
+
+	    /* Position in delaylist is recorded in tag field */
+	    testddata = snode->tag[minmax];
+
+	    if (testddata->backtrace->receiver == receiver) {
+		/* Is delay worse than that already recorded?  If so, replace it */
+		if (TIME_WORSE(minmax, delay[minmax], testddata->backtrace->delay)) {
+		    /* Replace the existing path record */
+		    testddata->backtrace = newbtdata[minmax];
+		    ctx->recorded++;
+		}
+	    }
+	    else
+		fprintf(stderr, "ERROR:  Bad endpoint tag!\n");
+	}
+	else
+	    testddata = NULL;
+
+	// If we have found a propagation path from source to dest,
+	// record it in delaylist.
+
+	if (testddata == NULL) {
+	    ctx->found[minmax]++;
+	    newddata = (ddataptr)arena_alloc(&ctx->scratch, sizeof(delaydata));
+	    newddata->delay = 0.0;
+	    newddata->trans = 0.0;
+	    newddata->backtrace = newbtdata[minmax];
+	    newddata->next = delaylist[minmax];
+	    delaylist[minmax] = newddata;
+
+	    /* Mark the receiver as having been visited */
+	    snode->tag[minmax] = delaylist[minmax];
+	    ctx->recorded++;
+	}
+    }
+
+    for (minmax = first; minmax <= last; minmax++) {
+	snode->metric[minmax] = TIME_SIGN(minmax) * delay[minmax];
+	if (pruning == PRUNE_PARETO)
+	    pareto_insert(ctx, &snode->front[minmax], dir,
+			TIME_SIGN(minmax) * delay[minmax],
+			TIME_SIGN(minmax) * trans[minmax]);
+    }
+    if (ctx->recorded == recorded) arena_release(&ctx->scratch, mark);
+}
+
+/*--------------------------------------------------------------*/
+/* Find the entry for "testlink" in "clocklist", and set its	*/
+/* delay and transition time to the arrival of the clock edge	*/
+/* "dir" at "testlink" from the sources of the clock, for	*/
+/* analysis "minmax".  The arrivals are looked up in "clocks"	*/
+/* (see find_clock_latencies()).				*/
+/*								*/
+/* Return a pointer to the entry, or NULL if "testlink" is not	*/
+/* in "clocklist".						*/
+/*--------------------------------------------------------------*/
+
+static btptr find_clock_transition(clocktree *clocks, btptr clocklist, connptr testlink,
+		short dir, char minmax)
+{
+    btptr testclock;
+    clocknode *cnode;
+    int idx;
+
+    for (testclock = clocklist; testclock; testclock = testclock->next)
+	if (testclock->receiver == testlink) break;
+    if (testclock == NULL) return NULL;	// Error---testlink wasn't in clocklist!
+
+    idx = ((testlink->index >= 0) && (testlink->index < clocks->numindex)) ?
+		clocks->index[testlink->index] : -1;
+    if (idx >= 0) {
+	cnode = clocks->nodes + idx;
+	testclock->delay = cnode->delay[minmax][dir - 1];
+	testclock->trans = cnode->trans[minmax][dir - 1];
+    }
+    return testclock;
+}
+
+/*--------------------------------------------------------------*/
+/* Given an instance record, find the pin of the instance that	*/
+/* is the clock, if the instance is a flop.  If the instance is	*/
+/* not a flop, return NULL.					*/
+/*--------------------------------------------------------------*/
+
+static connptr find_register_clock(instptr testinst)
+{
+    connptr testconn;
+
+    for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+	if (testconn->refpin && (testconn->refpin->type & DFFCLK))
+	    return testconn;
+
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the arrival of the clock at connection "testlink" of	*/
+/* the clock network, for each analysis and edge direction,	*/
+/* using the delays of process corner "cn".  The arrivals at	*/
+/* the gate driving "testlink" are found first, back to the	*/
+/* sources of the clock (module inputs or flop outputs), where	*/
+/* both edges arrive at time zero.  As with			*/
+/* find_clock_source(), this does not differentiate between	*/
+/* the clock and any gating signal.  Each connection is found	*/
+/* once, and recorded in "clocks".				*/
+/*								*/
+/* Return the index of the clock node of "testlink", or -1 if	*/
+/* it is not a graph node or is on a loop in the clock network.	*/
+/*--------------------------------------------------------------*/
+
+static int
+find_clock_latency(corner *cn, clocktree *clocks, connptr testlink)
+{
+    clocknode	newnode, *cnode;
+    connptr	driver, iinput;
+    instptr	iupstream;
+    double	delay, trans;
+    short	indir, outdir, dir;
+    char	found[2][2], minmax;
+    int		idx, inidx;
+
+    if ((testlink->index < 0) || (testlink->index >= clocks->numindex)) return -1;
+    idx = clocks->index[testlink->index];
+    if (idx != -1) return (idx >= 0) ? idx : -1;
+    clocks->index[testlink->index] = -2;	// Being found
+
+    memset(&newnode, 0, sizeof(clocknode));
+    memset(found, 0, sizeof(found));
+
+    driver = testlink->refnet->driver;
+    iupstream = (driver) ? driver->refinst : NULL;
+    if ((iupstream != NULL) && !(driver->refpin->type & DFFOUT)) {
+	for (iinput = iupstream->in_connects; iinput; iinput = iinput->next) {
+	    inidx = find_clock_latency(cn, clocks, iinput);
+	    if (inidx < 0) continue;
+	    cnode = clocks->nodes + inidx;
+
+	    for (indir = RISING; indir <= FALLING; indir++) {
+		outdir = calc_dir(iinput->refpin, indir);
+		for (dir = RISING; dir <= FALLING; dir++) {
+		    if (!(outdir & dir)) continue;
+		    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+			delay = cnode->delay[minmax][indir - 1] + calc_prop_delay(cn,
+				cnode->trans[minmax][indir - 1], iinput, dir, minmax);
+			trans = calc_transition(cn, cnode->trans[minmax][indir - 1],
+				iinput, dir, minmax);
+			if (!found[minmax][dir - 1] || TIME_WORSE(minmax, delay,
+					newnode.delay[minmax][dir - 1])) {
+			    newnode.delay[minmax][dir - 1] = delay;
+			    newnode.trans[minmax][dir - 1] = trans;
+			    found[minmax][dir - 1] = 1;
+			}
+		    }
+		}
+	    }
+	}
+    }
+
+    if (clocks->numnodes == clocks->maxnodes) {
+	clocks->maxnodes = (clocks->maxnodes == 0) ? 64 : 2 * clocks->maxnodes;
+	clocks->nodes = (clocknode *)realloc(clocks->nodes,
+			clocks->maxnodes * sizeof(clocknode));
+    }
+    idx = clocks->numnodes++;
+    clocks->nodes[idx] = newnode;
+    clocks->index[testlink->index] = idx;
+    return idx;
+}
+
+/*--------------------------------------------------------------*/
+/* Discard the clock arrivals in "clocks".			*/
+/*--------------------------------------------------------------*/
+
+static void
+free_clock_tree(clocktree *clocks)
+{
+    if (clocks->index != NULL) free(clocks->index);
+    if (clocks->nodes != NULL) free(clocks->nodes);
+    clocks->index = NULL;
+    clocks->nodes = NULL;
+    clocks->numindex = 0;
+    clocks->numnodes = 0;
+    clocks->maxnodes = 0;
+    clocks->valid = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the arrival of the clock at every register clock and	*/
+/* launch point of design "des", and at the clock network	*/
+/* upstream of them, in a single pass over the clock network.	*/
+/* The arrivals are kept in des->clocks, so each launch point	*/
+/* and path endpoint looks up its clock arrival instead of	*/
+/* tracing the clock network back to its sources again.		*/
+/*--------------------------------------------------------------*/
+
+static void
+find_clock_latencies(design *des)
+{
+    clocktree	*clocks = &des->clocks;
+    connlistptr	testlink;
+    connptr	testconn;
+    instptr	testinst;
+    int		i;
+
+    free_clock_tree(clocks);
+    clocks->numindex = des->graph->numnodes;
+    clocks->index = (int *)malloc(clocks->numindex * sizeof(int));
+    for (i = 0; i < clocks->numindex; i++)
+	clocks->index[i] = -1;
+
+    for (testlink = des->clockconnlist; testlink; testlink = testlink->next)
+	if (testlink->connection->refpin)
+	    find_clock_latency(des->corner, clocks, testlink->connection);
+
+    for (testinst = des->instlist; testinst; testinst = testinst->next) {
+	testconn = find_register_clock(testinst);
+	if (testconn != NULL)
+	    find_clock_latency(des->corner, clocks, testconn);
+    }
+    clocks->valid = 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Given an edge direction (RISING or FALLING) at a source net,	*/
+/* and given a destination net, find the sense of the signal	*/
+/* when it arrives at the destination net.  Return 0 if the	*/
+/* destination is not downstream of the source.			*/
+/*								*/
+/* The search goes back from the destination toward the source,	*/
+/* through the gate inputs driving each net, so that it covers	*/
+/* only the fan-in of the destination (as find_clock_source()	*/
+/* does) and not the whole fanout of a clock net.		*/
+/*--------------------------------------------------------------*/
+
+static short find_edge_dir(short dir, netptr sourcenet, netptr destnet) {
+    short indir;
+    connptr driver, iinput;
+    instptr iupstream;
+
+    if (sourcenet == destnet) return dir;
+
+    driver = destnet->driver;
+    iupstream = (driver) ? driver->refinst : NULL;
+    if (iupstream == NULL) return 0;		/* Reached a module input */
+
+    for (iinput = iupstream->in_connects; iinput; iinput = iinput->next) {
+	if (iinput->refpin == NULL) continue;
+	if ((iinput->refpin->type & REGISTER_IN) != 0) continue;
+	indir = find_edge_dir(dir, sourcenet, iinput->refnet);
+	if (indir != 0) return calc_dir(iinput->refpin, indir);
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the sources of the clock at launch point "thisconn"	*/
+/* for use by find_launch_data() in more than one analysis.	*/
+/* Return NULL if "thisconn" is a module input.  The list must	*/
+/* be freed by the caller.					*/
+/*--------------------------------------------------------------*/
+
+static btptr
+find_launch_sources(connptr thisconn)
+{
+    btptr clocklist = NULL;
+
+    if (thisconn->refpin)
+	find_clock_source(thisconn, &clocklist,
+		(thisconn->refpin->refcell->type & CLK_SENSE_MASK) ? FALLING : RISING);
+    return clocklist;
+}
+
+/*--------------------------------------------------------------*/
+/* Fill in the launch point record "ldata" for a path search	*/
+/* starting at "thisconn", which is either the clock pin of a	*/
+/* flop or a module input.  For a flop, find the sources of the	*/
+/* clock and the clock source with the worst-case transition	*/
+/* time at the flop clock pin.  The sources of the clock do not	*/
+/* depend on the analysis type;  if "clocklist" is not NULL, it	*/
+/* is the list found by find_launch_sources() for the same	*/
+/* launch point, and is copied instead of being found again.	*/
+/* Clock delays are looked up in "clocks".			*/
+/*--------------------------------------------------------------*/
+
+static void
+find_launch_data(clocktree *clocks, connptr thisconn, launch *ldata, btptr clocklist,
+		char minmax)
+{
+    btptr	newbt, lastbt;
+    pinptr	testpin;
+    cellptr	testcell;
+
+    ldata->conn = thisconn;
+    ldata->clocklist = NULL;
+    ldata->source = NULL;
+    ldata->bt = NULL;
+
+    testpin = thisconn->refpin;
+    if (testpin) {
+	testcell = testpin->refcell;
+
+	// Sense is positive for rising edge-triggered flops, negative for
+	// falling edge-triggered flops
+	ldata->dir = (testcell->type & CLK_SENSE_MASK) ? FALLING : RISING;
+
+	// Find the sources of the clock at the path start
+	if (clocklist == NULL)
+	    find_clock_source(thisconn, &ldata->clocklist, ldata->dir);
+	else {
+	    lastbt = NULL;
+	    for (; clocklist; clocklist = clocklist->next) {
+		newbt = (btptr)malloc(sizeof(btdata));
+		*newbt = *clocklist;
+		newbt->next = NULL;
+		if (lastbt == NULL)
+		    ldata->clocklist = newbt;
+		else
+		    lastbt->next = newbt;
+		lastbt = newbt;
+	    }
+	}
+
+	// Find the clock source with the worst-case transition time at testlink
+	// (Note:  For maximum path delay, find minimum clock transistion, and vice versa)
+	ldata->source = find_clock_transition(clocks, ldata->clocklist, thisconn,
+			ldata->dir, !minmax);
+	if (ldata->source == NULL)
+	    ldata->trans = 0.0;
+	else
+	    ldata->trans = ldata->source->trans;
+    }
+    else {
+	// Connection is an input pin;  must calculate both rising and falling edges.
+	ldata->dir = EITHER;
+	ldata->trans = 0.0;	// To-do: use designated input transition time
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Complete the delay record of a path found by the path	*/
+/* search, which starts at "thisconn" with clock sources in	*/
+/* "clocklist" and clock source record "selectedsource".  Add	*/
+/* the clock skew between source and destination and the setup	*/
+/* or hold time at the destination (in process corner "cn",	*/
+/* with clock arrivals in "clocks"), and report on the path if	*/
+/* in verbose mode.						*/
+/*--------------------------------------------------------------*/
+
+static void
+terminate_path(corner *cn, clocktree *clocks, ddataptr testddata, connptr thisconn,
+		btptr clocklist, btptr selectedsource, char minmax)
+{
+    netptr	commonclock;
+    connptr     testconn;
+    instptr     testinst;
+    btptr 	clock2list, backtrace, freebt;
+    btptr	selecteddest;
+
+    short	destdir;
+    double	setupdelay, holddelay;
+    char	clk_sense_inv, clk_invert;
+
+    clock2list = NULL;
+
+    // Copy last backtrace delay to testddata.
+    testddata->delay = testddata->backtrace->delay;
+    testddata->trans = testddata->backtrace->trans;
+    testinst = testddata->backtrace->receiver->refinst;
+
+    if (testinst != NULL) {
+	// Find the sources of the clock at the path end
+	destdir = (testinst->refcell->type & CLK_SENSE_MASK) ? FALLING : RISING;
+	testconn = find_register_clock(testinst);
+	find_clock_source(testconn, &clock2list, destdir);
+	selecteddest = find_clock_transition(clocks, clock2list, testconn, destdir,
+			!minmax);
+
+	// Find the connection that is common to both clocks
+	commonclock = find_common_clock(clocklist, clock2list);
+	if (commonclock == NULL) {
+	    // Warn about asynchronous clock sources
+	    if (verbose > 0) {
+		fflush(stdout);
+		fprintf(stderr, "Independent clock nets \"%s\" and \"%s\""
+			" drive related gates!\n",
+			testconn->refnet->name, thisconn->refnet->name);
+	    }
+	    clk_invert = -1;
+	}
+	else {
+	    // Add or subtract difference in arrival times between source and
+	    // destination clocks
+
+	    if (selecteddest != NULL && selectedsource != NULL) {
+		testddata->delay += selecteddest->delay;
+		testddata->delay -= selectedsource->delay;
+
+		/* Check if the clock signal arrives at both flops with the	*/
+		/* same edge type (both rising or both falling).		*/
+
+		clk_invert = (find_edge_dir(RISING, commonclock,
+					selectedsource->receiver->refnet) ==
+				find_edge_dir(RISING, commonclock,
+					selecteddest->receiver->refnet)) ? 0 : 1;
+	    }
+
+	    if (minmax == MAXIMUM_TIME) {
+		// Add setup time for destination clocks
+		setupdelay = calc_setup_time(testddata->trans,
+				CORNER_PIN(cn, testddata->backtrace->receiver),
+				selecteddest->trans,
+				testddata->backtrace->dir, minmax);
+		testddata->delay += setupdelay;
+	    }
+	    else {
+		// Subtract hold time for destination clocks
+		holddelay = calc_hold_time(testddata->trans,
+				CORNER_PIN(cn, testddata->backtrace->receiver),
+				selecteddest->trans,
+				testddata->backtrace->dir, minmax);
+		testddata->delay -= holddelay;
+	    }
+
+	    if (verbose > 0)
+		fprintf(stdout, "Path terminated on flop \"%s\" input with max delay %g ps\n",
+			testconn->refinst->name, testddata->delay);
+
+	    for (backtrace = testddata->backtrace; backtrace->next;
+			backtrace = backtrace->next) {
+		if (verbose > 0)
+		    fprintf(stdout, "   %g (%s) %s/%s -> %s/%s\n",
+				backtrace->delay,
+				backtrace->receiver->refnet->name,
+				backtrace->receiver->refnet->driver->refinst->name,
+				backtrace->receiver->refnet->driver->refpin->name,
+				backtrace->receiver->refinst->name,
+				backtrace->receiver->refpin->name);
+	    }
+	    if (verbose > 0)
+		fprintf(stdout, "   000.000 (%s) %s/%s -> %s/%s\n",
+			backtrace->receiver->refnet->name,
+			backtrace->receiver->refinst->name,
+			backtrace->receiver->refpin->name,
+			backtrace->receiver->refinst->name,
+			backtrace->receiver->refinst->out_connects->refpin->name);
+
+	    if (selecteddest != NULL && selectedsource != NULL) {
+		if (verbose > 0) {
+		    if (selectedsource->receiver->refnet != selecteddest->receiver->refnet) {
+			fprintf(stdout, "   %g %s to %s clock skew\n",
+				selecteddest->delay - selectedsource->delay,
+				selectedsource->receiver->refnet->name,
+				selecteddest->receiver->refnet->name);
+		    }
+		}
+
+		/* Check if the flops have the same clock sense */
+		/* (both are clock rising edge or both are clock falling edge type) */
+
+		if ((testinst->refcell->type & CLK_SENSE_MASK) !=
+				(backtrace->receiver->refinst->refcell->type
+				& CLK_SENSE_MASK))
+		    clk_sense_inv = 1;
+		else
+		    clk_sense_inv = 0;
+
+		/* If the two flops don't clock at the same time, then issue a	*/
+		/* warning that the slack time loses half a clock period.	*/
+
+		if ((verbose > 0) && (clk_invert != -1) && (clk_sense_inv != clk_invert)) {
+		    fprintf(stdout, "   Clocks are inverted relative to one another,\n");
+		    fprintf(stdout, "   implying a maximum propagation delay of 1/2 period.\n");
+		}
+	    }
+	    if (selecteddest != NULL && selectedsource != NULL) {
+		if (verbose > 0) {
+		    if (minmax == MAXIMUM_TIME)
+			fprintf(stdout, "   %g setup time at destination\n", setupdelay);
+		    else
+			fprintf(stdout, "   %g hold time at destination\n", holddelay);
+		}
+	    }
+
+	    if (verbose > 0) fprintf(stdout, "\n");
+	}
+    }
+    else if (verbose > 0) {
+	fprintf(stdout, "Path terminated on output \"%s\" with max delay %g ps\n",
+			testddata->backtrace->receiver->refnet->name, testddata->delay);
+
+	backtrace = testddata->backtrace;
+	fprintf(stdout, "   %g (%s) %s/%s -> [output pin]\n",
+		backtrace->delay,
+		backtrace->receiver->refnet->name,
+		backtrace->receiver->refnet->driver->refinst->name,
+		backtrace->receiver->refnet->driver->refpin->name);
+
+	for (backtrace = backtrace->next; backtrace->next; backtrace = backtrace->next) {
+	    fprintf(stdout, "   %g (%s) %s/%s -> %s/%s\n",
+			backtrace->delay,
+			backtrace->receiver->refnet->name,
+			backtrace->receiver->refnet->driver->refinst->name,
+			backtrace->receiver->refnet->driver->refpin->name,
+			backtrace->receiver->refinst->name,
+			backtrace->receiver->refpin->name);
+	}
+	fprintf(stdout, "   000.000 (%s) %s/%s -> %s/%s\n\n",
+		backtrace->receiver->refnet->name,
+		backtrace->receiver->refinst->name,
+		backtrace->receiver->refpin->name,
+		backtrace->receiver->refinst->name,
+		backtrace->receiver->refinst->out_connects->refpin->name);
+    }
+
+    // Clean up clock2list
+    while (clock2list != NULL) {
+	freebt = clock2list;
+	clock2list = clock2list->next;
+	free(freebt);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Find the clock that captures a path at endpoint "endconn",	*/
+/* as terminate_path() does:  the sources of the clock at the	*/
+/* endpoint's register are left in "clock2list", and the clock	*/
+/* record with the arrival at the register clock pin (from	*/
+/* "clocks") is returned.  Both are NULL if the endpoint is a	*/
+/* module output.  The caller frees "clock2list".		*/
+/*--------------------------------------------------------------*/
+
+static btptr
+find_capture_clock(clocktree *clocks, connptr endconn, btptr *clock2list,
+		char minmax)
+{
+    connptr testconn;
+    instptr testinst;
+    short   destdir;
+
+    *clock2list = NULL;
+    testinst = endconn->refinst;
+    if (testinst == NULL) return NULL;
+
+    destdir = (testinst->refcell->type & CLK_SENSE_MASK) ? FALLING : RISING;
+    testconn = find_register_clock(testinst);
+    find_clock_source(testconn, clock2list, destdir);
+    return find_clock_transition(clocks, *clock2list, testconn, destdir, !minmax);
+}
+
+/*--------------------------------------------------------------*/
+/* Return the delay of a path from launch point "lptr" ending	*/
+/* at endpoint "endconn" with edge direction "dir", arrival	*/
+/* time "delay" and transition time "trans", as			*/
+/* terminate_path() finds it but without reporting on the	*/
+/* path:  if the clock at the endpoint ("clock2list" and	*/
+/* "selecteddest", see find_capture_clock()) captures the	*/
+/* path, the clock skew and the setup or hold time in process	*/
+/* corner "cn" are added.  If "captured" is not NULL, it is	*/
+/* set to 1 if the path is captured, or 0 if not (including	*/
+/* paths to a module output).					*/
+/*--------------------------------------------------------------*/
+
+static double
+capture_path_delay(corner *cn, connptr endconn, short dir, double delay,
+		double trans, launch *lptr, btptr clock2list, btptr selecteddest,
+		char minmax, char *captured)
+{
+    if (captured != NULL) *captured = 0;
+    if (endconn->refinst == NULL) return delay;
+    if (find_common_clock(lptr->clocklist, clock2list) == NULL) return delay;
+    if (captured != NULL) *captured = 1;
+
+    if (selecteddest != NULL && lptr->source != NULL)
+	delay += selecteddest->delay - lptr->source->delay;
+
+    if (minmax == MAXIMUM_TIME)
+	delay += calc_setup_time(trans, CORNER_PIN(cn, endconn), selecteddest->trans,
+			dir, minmax);
+    else
+	delay -= calc_hold_time(trans, CORNER_PIN(cn, endconn), selecteddest->trans,
+			dir, minmax);
+    return delay;
+}
+
+/*--------------------------------------------------------------*/
+/* Create the scratch space for a path search thread, timing	*/
+/* process corner "cn".						*/
+/*--------------------------------------------------------------*/
+
+static searchctx *
+create_search_context(tgraph *graph, corner *cn)
+{
+    searchctx *ctx;
+    int i;
+
+    ctx = (searchctx *)malloc(sizeof(searchctx));
+    ctx->graph = graph;
+    ctx->corner = cn;
+    for (i = 0; i < 2; i++)
+	arena_init(&ctx->pool[i]);
+    ctx->nodes = (searchnode *)calloc(graph->numconns, sizeof(searchnode));
+    ctx->epoch = 0;
+    arena_init(&ctx->scratch);
+    arena_init(&ctx->fronts);
+    ctx->freepts = NULL;
+    ctx->recorded = 0;
+    memset(&ctx->counts, 0, sizeof(searchcount));
+    return ctx;
+}
+
+/*--------------------------------------------------------------*/
+/* Free the scratch space of a path search thread.  The paths	*/
+/* it found are moved into "pool" (indexed by analysis type).	*/
+/*--------------------------------------------------------------*/
+
+static void
+free_search_context(searchctx *ctx, arena **pool)
+{
+    int i;
+
+    for (i = 0; i < 2; i++) {
+	if (pool[i] != NULL)
+	    arena_merge(pool[i], &ctx->pool[i]);
+	else
+	    arena_free(&ctx->pool[i]);
+    }
+    arena_free(&ctx->scratch);
+    arena_free(&ctx->fronts);
+    profile_add_counts(&ctx->counts);
+    free(ctx->nodes);
+    free(ctx);
+}
+
+/*--------------------------------------------------------------*/
+/* Copy the backtrace "backtrace" into "pool" and return the	*/
+/* copy.  Each record copied is marked as moved and pointed at	*/
+/* its copy, so that the common prefixes of the backtraces	*/
+/* copied remain shared.					*/
+/*--------------------------------------------------------------*/
+
+static btptr
+copy_backtrace(arena *pool, btptr backtrace)
+{
+    btptr newbt, nextbt, firstbt, lastbt;
+
+    firstbt = lastbt = NULL;
+    while (backtrace != NULL) {
+	if (backtrace->dir == EDGE_MOVED) {
+	    newbt = backtrace->next;
+	    nextbt = NULL;
+	}
+	else {
+	    newbt = (btptr)arena_alloc(pool, sizeof(btdata));
+	    *newbt = *backtrace;
+	    newbt->next = NULL;
+	    nextbt = backtrace->next;
+	    backtrace->dir = EDGE_MOVED;
+	    backtrace->next = newbt;
+	}
+	if (lastbt == NULL)
+	    firstbt = newbt;
+	else
+	    lastbt->next = newbt;
+	lastbt = newbt;
+	backtrace = nextbt;
+    }
+    return firstbt;
+}
+
+/*--------------------------------------------------------------*/
+/* Search all paths from the launch point with index "idx" in	*/
+/* "search", using the scratch space "ctx", for each analysis	*/
+/* in search->analyses.  The paths found are left in		*/
+/* search->results[minmax][idx].  Outside of verbose mode, the	*/
+/* paths are also completed here.  In verbose mode, that is	*/
+/* left to find_clock_to_term_paths(), so that output from	*/
+/* different threads is not interleaved.			*/
+/*--------------------------------------------------------------*/
+
+static void
+search_launch_point(pathsearch *search, searchctx *ctx, int idx)
+{
+    launch   *lptr;
+    ddataptr delaylist[2], testddata, newlist, newddata, lastddata;
+    btptr    freebt, clocklist, backtrace[2];
+    arenamark empty;
+    double   delay[2], trans[2];
+    short    dir;
+    char     minmax;
+    int	     i;
+
+    empty.block = NULL;
+    empty.used = 0;
+
+    // Start a new search, which removes all tags and resets the delay
+    // metrics (see find_path_delay()).  Only when the search number
+    // wraps around must the connections be reset explicitly.
+
+    if (++ctx->epoch == 0) {
+	for (i = 0; i < search->graph->numconns; i++)
+	    ctx->nodes[i].visit = 0;
+	ctx->epoch = 1;
+    }
+
+    // The sources of the clock are shared by the analyses
+
+    clocklist = NULL;
+    if (search->analyses == BOTH_ANALYSES)
+	clocklist = find_launch_sources(search->launches[MAXIMUM_TIME][idx].conn);
+
+    dir = 0;
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(search->analyses & ANALYSIS(minmax))) continue;
+	lptr = search->launches[minmax] + idx;
+	find_launch_data(search->clocks, lptr->conn, lptr, clocklist, minmax);
+	dir = lptr->dir;
+	delay[minmax] = 0.0;
+	trans[minmax] = lptr->trans;
+	backtrace[minmax] = NULL;
+	delaylist[minmax] = NULL;
+	ctx->found[minmax] = 0;
+    }
+    while (clocklist != NULL) {
+	freebt = clocklist;
+	clocklist = clocklist->next;
+	free(freebt);
+    }
+
+    // Find all paths from the launch point to output or a flop input,
+    // and compute delay
+
+    find_path_delay(ctx, dir, delay, trans, search->launches[MAXIMUM_TIME][idx].conn,
+		backtrace, delaylist, search->analyses);
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(search->analyses & ANALYSIS(minmax))) continue;
+	lptr = search->launches[minmax] + idx;
+	search->numfound[minmax][idx] = ctx->found[minmax];
+
+	// Copy the paths found out of the scratch space, leaving behind the
+	// backtraces of paths that were superseded during the search.
+
+	newlist = NULL;
+	lastddata = NULL;
+	for (testddata = delaylist[minmax]; testddata; testddata = testddata->next) {
+	    newddata = (ddataptr)arena_alloc(&ctx->pool[minmax], sizeof(delaydata));
+	    *newddata = *testddata;
+	    newddata->backtrace = copy_backtrace(&ctx->pool[minmax],
+			testddata->backtrace);
+	    newddata->next = NULL;
+	    if (lastddata == NULL)
+		newlist = newddata;
+	    else
+		lastddata->next = newddata;
+	    lastddata = newddata;
+	}
+	search->results[minmax][idx] = newlist;
+
+	if (verbose > 0) continue;
+
+	for (testddata = newlist; testddata; testddata = testddata->next)
+	    terminate_path(search->corner, search->clocks, testddata, lptr->conn,
+			lptr->clocklist, lptr->source, minmax);
+
+	while (lptr->clocklist != NULL) {
+	    freebt = lptr->clocklist;
+	    lptr->clocklist = lptr->clocklist->next;
+	    free(freebt);
+	}
+    }
+    arena_release(&ctx->scratch, empty);
+    arena_release(&ctx->fronts, empty);
+    ctx->freepts = NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Get the next launch point for search thread "id".  Take it	*/
+/* from the front of the thread's own range if possible, or	*/
+/* else steal one from the back of another thread's range.	*/
+/* Return -1 if there is no work left.				*/
+/*--------------------------------------------------------------*/
+
+static int
+next_launch_point(pathsearch *search, int id)
+{
+    workrange *range;
+    int idx, i;
+
+    range = search->ranges + id;
+    pthread_mutex_lock(&range->lock);
+    idx = (range->next < range->last) ? range->next++ : -1;
+    pthread_mutex_unlock(&range->lock);
+    if (idx >= 0) return idx;
+
+    for (i = 1; i < search->numthreads; i++) {
+	range = search->ranges + ((id + i) % search->numthreads);
+	pthread_mutex_lock(&range->lock);
+	idx = (range->next < range->last) ? --range->last : -1;
+	pthread_mutex_unlock(&range->lock);
+	if (idx >= 0) return idx;
+    }
+    return -1;
+}
+
+/*--------------------------------------------------------------*/
+/* Main routine of a path search thread.			*/
+/*--------------------------------------------------------------*/
+
+static void *
+path_search_thread(void *arg)
+{
+    searchthread *thread = (searchthread *)arg;
+    pathsearch	 *search = thread->search;
+    int		 idx;
+
+    while ((idx = next_launch_point(search, thread->id)) >= 0)
+	search_launch_point(search, thread->ctx, idx);
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Search all paths from the clocked data outputs of		*/
+/* "clockedlist" to either output pins or data inputs of other	*/
+/* flops, with the delays of process corner "cn".		*/
+/*								*/
+/* "analyses" holds the ANALYSIS() bit of each analysis type to	*/
+/* search for:  the maximum delay (MAXIMUM_TIME), the minimum	*/
+/* delay (MINIMUM_TIME), or both in a single traversal.  For	*/
+/* each analysis, a master list of all backtraces is returned	*/
+/* in masterlist[minmax], with the backtrace and delay records	*/
+/* allocated from pool[minmax], and the number of paths		*/
+/* recorded in numpaths[minmax].				*/
+/*								*/
+/* The search from each launch point is independent, and if	*/
+/* "numthreads" is greater than 1, the launch points are	*/
+/* divided among that many threads.  The results are merged	*/
+/* into masterlist in the order of "clockedlist", so the result	*/
+/* does not depend on the number of threads.			*/
+/*--------------------------------------------------------------*/
+
+static void find_clock_to_term_paths(tgraph *graph, corner *cn, clocktree *clocks,
+		connlistptr clockedlist, ddataptr *masterlist, arena **pool,
+		int *numpaths, char analyses)
+{
+    pathsearch	search;
+    searchthread *threads;
+    pthread_t	*tids;
+    searchctx	*ctx;
+    connptr     thisconn;
+    connlistptr testlink;
+    launch	*lptr;
+    btptr 	freebt;
+    ddataptr    delaylist, testddata;
+    char	minmax;
+    int		n, i;
+
+    search.graph = graph;
+    search.corner = cn;
+    search.clocks = clocks;
+    search.analyses = analyses;
+    search.numlaunch = 0;
+    for (testlink = clockedlist; testlink; testlink = testlink->next)
+	search.numlaunch++;
+
+    // The maximum time records are always allocated, as they also
+    // hold the launch point connections.
+
+    analyses |= ANALYSIS(MAXIMUM_TIME);
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(analyses & ANALYSIS(minmax))) continue;
+	search.launches[minmax] = (launch *)malloc(search.numlaunch * sizeof(launch));
+	search.results[minmax] = (ddataptr *)malloc(search.numlaunch * sizeof(ddataptr));
+	search.numfound[minmax] = (int *)malloc(search.numlaunch * sizeof(int));
+
+	for (i = 0, testlink = clockedlist; testlink; testlink = testlink->next, i++) {
+	    search.launches[minmax][i].conn = testlink->connection;
+	    search.launches[minmax][i].clocklist = NULL;
+	    search.results[minmax][i] = NULL;
+	    search.numfound[minmax][i] = 0;
+	}
+    }
+
+    search.numthreads = (numthreads < search.numlaunch) ? numthreads : search.numlaunch;
+    if (search.numthreads <= 1) {
+	ctx = create_search_context(graph, cn);
+	for (i = 0; i < search.numlaunch; i++)
+	    search_launch_point(&search, ctx, i);
+	free_search_context(ctx, pool);
+    }
+    else {
+	// Divide the launch points evenly among the threads to start with
+
+	search.ranges = (workrange *)malloc(search.numthreads * sizeof(workrange));
+	threads = (searchthread *)malloc(search.numthreads * sizeof(searchthread));
+	tids = (pthread_t *)malloc(search.numthreads * sizeof(pthread_t));
+
+	for (i = 0; i < search.numthreads; i++) {
+	    pthread_mutex_init(&search.ranges[i].lock, NULL);
+	    search.ranges[i].next = (int)(((long)search.numlaunch * i) /
+			search.numthreads);
+	    search.ranges[i].last = (int)(((long)search.numlaunch * (i + 1)) /
+			search.numthreads);
+	    threads[i].search = &search;
+	    threads[i].ctx = create_search_context(graph, cn);
+	    threads[i].id = i;
+	}
+	for (i = 0; i < search.numthreads; i++)
+	    pthread_create(&tids[i], NULL, path_search_thread, &threads[i]);
+	for (i = 0; i < search.numthreads; i++) {
+	    pthread_join(tids[i], NULL);
+	    free_search_context(threads[i].ctx, pool);
+	}
+
+	for (i = 0; i < search.numthreads; i++)
+	    pthread_mutex_destroy(&search.ranges[i].lock);
+	free(search.ranges);
+	free(threads);
+	free(tids);
+    }
+
+    // Merge the results in launch point order, for the maximum delay
+    // analysis first
+
+    for (minmax = MAXIMUM_TIME; minmax >= MINIMUM_TIME; minmax--) {
+	if (!(analyses & ANALYSIS(minmax))) continue;
+	if (search.analyses & ANALYSIS(minmax)) {
+	    numpaths[minmax] = 0;
+	    for (i = 0; i < search.numlaunch; i++) {
+		lptr = search.launches[minmax] + i;
+		thisconn = lptr->conn;
+		delaylist = search.results[minmax][i];
+		n = search.numfound[minmax][i];
+		numpaths[minmax] += n;
+
+		// Report on paths and their maximum delays
+		if (verbose > 0) {
+		    fprintf(stdout, "Paths starting at flop \"%s\" clock:\n\n",
+				thisconn->refinst->name);
+		    fprintf(stdout, "%d paths traced (%d total).\n\n", n,
+				numpaths[minmax]);
+		    fflush(stdout);
+
+		    for (testddata = delaylist; testddata; testddata = testddata->next)
+			terminate_path(cn, clocks, testddata, thisconn, lptr->clocklist,
+				lptr->source, minmax);
+		}
+
+		// Link delaylist data to the beginning of masterlist
+
+		if (delaylist) {
+		    for (testddata = delaylist; testddata->next;
+				testddata = testddata->next);
+		    testddata->next = masterlist[minmax];
+		    masterlist[minmax] = delaylist;
+		}
+
+		// Free up clocklist
+		while (lptr->clocklist != NULL) {
+		    freebt = lptr->clocklist;
+		    lptr->clocklist = lptr->clocklist->next;
+		    free(freebt);
+		}
+	    }
+	}
+	free(search.launches[minmax]);
+	free(search.results[minmax]);
+	free(search.numfound[minmax]);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Return the net that a signal arriving at connection		*/
+/* "testconn" propagates to, or NULL if the connection is a	*/
+/* path endpoint (a module output or a register input).		*/
+/*--------------------------------------------------------------*/
+
+static netptr propagate_net(connptr testconn)
+{
+    pinptr testpin;
+    instptr testinst;
+
+    testpin = testconn->refpin;
+    if (testpin == NULL) return NULL;
+    if ((testpin->type & REGISTER_IN) != 0) return NULL;
+
+    testinst = testconn->refinst;
+    if ((testinst == NULL) || (testinst->out_connects == NULL)) return NULL;
+    return testinst->out_connects->refnet;
+}
+
+/*--------------------------------------------------------------*/
+/* Return 1 if an arrival with the given values is worse (later	*/
+/* for maximum time, earlier for minimum time) than the arrival	*/
+/* record "aptr", or if "aptr" is empty.  Ties are broken by	*/
+/* the worse transition time, then by the lower launch point,	*/
+/* predecessor and slot indexes, so that the result of		*/
+/* comparing a set of arrivals does not depend on the order in	*/
+/* which they are compared.  The incremental update (see	*/
+/* levelized_update()) relies on this.				*/
+/*--------------------------------------------------------------*/
+
+static int
+arrival_precedes(arrival *aptr, double delay, double trans, int pred,
+		short preddir, short predslot, int launchidx, char minmax)
+{
+    if (aptr->launch < 0) return 1;
+    if (delay != aptr->delay) return TIME_WORSE(minmax, delay, aptr->delay);
+    if (trans != aptr->trans) return TIME_WORSE(minmax, trans, aptr->trans);
+    if (launchidx != aptr->launch) return (launchidx < aptr->launch);
+    if (pred != aptr->pred) return (pred < aptr->pred);
+    if (preddir != aptr->preddir) return (preddir < aptr->preddir);
+    return (predslot < aptr->predslot);
+}
+
+/*--------------------------------------------------------------*/
+/* Add a copy of arrival record "newarr" to "list", the "depth"	*/
+/* arrival slots of one node and edge direction, which hold	*/
+/* the worst arrivals in order from worst to least worst.  If	*/
+/* the list is full, the least worst arrival is dropped.	*/
+/*--------------------------------------------------------------*/
+
+static void
+insert_arrival(arrival *list, int depth, arrival *newarr, char minmax)
+{
+    int i;
+
+    if (!arrival_precedes(list + depth - 1, newarr->delay, newarr->trans,
+		newarr->pred, newarr->preddir, newarr->predslot, newarr->launch,
+		minmax))
+	return;
+
+    for (i = depth - 1; i > 0; i--) {
+	if (!arrival_precedes(list + i - 1, newarr->delay, newarr->trans,
+		newarr->pred, newarr->preddir, newarr->predslot, newarr->launch,
+		minmax))
+	    break;
+	list[i] = list[i - 1];
+    }
+    list[i] = *newarr;
+}
+
+/*--------------------------------------------------------------*/
+/* Add a new arrival to "list" (see insert_arrival()), with no	*/
+/* backtrace.							*/
+/*--------------------------------------------------------------*/
+
+static void
+update_arrival(arrival *list, int depth, double delay, double trans, int pred,
+		short preddir, short predslot, int launchidx, char minmax)
+{
+    arrival newarr;
+
+    newarr.delay = delay;
+    newarr.trans = trans;
+    newarr.pred = pred;
+    newarr.preddir = preddir;
+    newarr.predslot = predslot;
+    newarr.launch = launchidx;
+    newarr.bt = NULL;
+    insert_arrival(list, depth, &newarr, minmax);
+}
+
+/*--------------------------------------------------------------*/
+/* Return 1 if path rank "rank" comes before "other" (see	*/
+/* pathrank), or 0 if not.					*/
+/*--------------------------------------------------------------*/
+
+static int
+rank_precedes(pathrank *rank, pathrank *other, char minmax)
+{
+    if (rank->captured != other->captured) return rank->captured;
+    return TIME_WORSE(minmax, rank->delay, other->delay);
+}
+
+/*--------------------------------------------------------------*/
+/* Add a copy of arrival record "newarr" to "list", the "depth"	*/
+/* arrival slots of one endpoint and edge direction, ordered by	*/
+/* path rank "newrank" (see pathrank) instead of by arrival	*/
+/* time.  "ranks" holds the rank of each filled slot.  Arrivals	*/
+/* of equal rank are kept in the order added.			*/
+/*--------------------------------------------------------------*/
+
+static void
+insert_ranked_arrival(arrival *list, pathrank *ranks, int depth, arrival *newarr,
+		pathrank *newrank, char minmax)
+{
+    int i;
+
+    for (i = depth; i > 0; i--) {
+	if ((list[i - 1].launch >= 0) && !rank_precedes(newrank, ranks + i - 1, minmax))
+	    break;
+	if (i < depth) {
+	    list[i] = list[i - 1];
+	    ranks[i] = ranks[i - 1];
+	}
+    }
+    if (i < depth) {
+	list[i] = *newarr;
+	ranks[i] = *newrank;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the arrival and transition times at the output of	*/
+/* the gate for a signal arriving at connection "receiver" with	*/
+/* edge direction "dir", arrival time "delay" and transition	*/
+/* time "trans".  Results for the rising and falling output	*/
+/* are placed in "newdelay" and "newtrans" (indexed by		*/
+/* direction - 1), using the delays of process corner "cn".	*/
+/* Return the output edge direction(s).				*/
+/*--------------------------------------------------------------*/
+
+static short
+levelized_gate_output(corner *cn, connptr receiver, short dir, double delay,
+		double trans, char minmax, double *newdelay, double *newtrans)
+{
+    short outdir;
+
+    outdir = calc_dir(receiver->refpin, dir);
+    if (outdir & RISING) {
+	newdelay[0] = delay + calc_prop_delay(cn, trans, receiver, RISING, minmax);
+	newtrans[0] = calc_transition(cn, trans, receiver, RISING, minmax);
+    }
+    if (outdir & FALLING) {
+	newdelay[1] = delay + calc_prop_delay(cn, trans, receiver, FALLING, minmax);
+	newtrans[1] = calc_transition(cn, trans, receiver, FALLING, minmax);
+    }
+    return outdir;
+}
+
+/*--------------------------------------------------------------*/
+/* Propagate a signal arriving at connection "receiver" with	*/
+/* edge direction "dir", arrival time "delay" and transition	*/
+/* time "trans" through the gate to each receiver on the gate's	*/
+/* output net (the graph arcs out of "receiver").  "pred" and	*/
+/* "predslot" are the graph node index of "receiver" and the	*/
+/* arrival slot there, or -1 if "receiver" is the launch point.	*/
+/*--------------------------------------------------------------*/
+
+static void
+levelized_propagate(tgraph *graph, levelstate *lstate, launch *lptr,
+		connptr receiver, short dir, double delay, double trans,
+		int pred, short predslot, int launchidx, char minmax)
+{
+    double  newdelay[2], newtrans[2];
+    short   outdir;
+    int	    i, node;
+
+    // Compute delay from gate input to output
+
+    outdir = levelized_gate_output(lstate->corner, receiver, dir, delay, trans,
+		minmax, newdelay, newtrans);
+
+    for (i = graph->arcstart[receiver->index]; i < graph->arcstart[receiver->index + 1];
+		i++) {
+	node = graph->arcs[i];
+
+	// Paths looping back to the launch point are truncated
+
+	if (node == lptr->conn->index) continue;
+
+	if (outdir & RISING)
+	    update_arrival(NODE_ARRIVALS(lstate, node, RISING), lstate->depth,
+			newdelay[0], newtrans[0], pred, dir, predslot, launchidx, minmax);
+	if (outdir & FALLING)
+	    update_arrival(NODE_ARRIVALS(lstate, node, FALLING), lstate->depth,
+			newdelay[1], newtrans[1], pred, dir, predslot, launchidx, minmax);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Generate the backtrace for the path ending in arrival slot	*/
+/* "slot" of graph node "node" with edge direction "dir" from	*/
+/* the predecessor links left by the levelized search.		*/
+/* Backtrace records are created once per arrival slot, so	*/
+/* paths share their common prefixes, and are allocated from	*/
+/* "pool".							*/
+/*--------------------------------------------------------------*/
+
+static btptr
+levelized_backtrace(tgraph *graph, levelstate *lstate, int node, short dir,
+		short slot, arena *pool)
+{
+    arrival *aptr;
+    launch  *lptr;
+    btptr   newbt, firstbt, lastbt;
+    double  skew;
+
+    firstbt = lastbt = NULL;
+    while (1) {
+	aptr = NODE_ARRIVALS(lstate, node, dir) + slot;
+	lptr = lstate->launches + aptr->launch;
+
+	if (aptr->bt != NULL) {
+	    // Remainder of the path already exists
+	    if (lastbt == NULL)
+		firstbt = aptr->bt;
+	    else
+		lastbt->next = aptr->bt;
+	    break;
+	}
+
+	skew = (lptr->source) ? lptr->source->delay : 0.0;
+	newbt = (btptr)arena_alloc(pool, sizeof(btdata));
+	newbt->delay = aptr->delay + skew;
+	newbt->trans = aptr->trans;
+	newbt->dir = dir;
+	newbt->receiver = graph->nodes[node];
+	newbt->next = NULL;
+	aptr->bt = newbt;
+
+	if (lastbt == NULL)
+	    firstbt = newbt;
+	else
+	    lastbt->next = newbt;
+	lastbt = newbt;
+
+	if (aptr->pred < 0) {
+	    // Reached the launch point
+	    if (lptr->bt == NULL) {
+		newbt = (btptr)arena_alloc(pool, sizeof(btdata));
+		newbt->delay = 0.0;
+		newbt->trans = lptr->trans;
+		newbt->dir = lptr->dir;
+		newbt->receiver = lptr->conn;
+		newbt->next = NULL;
+		lptr->bt = newbt;
+	    }
+	    lastbt->next = lptr->bt;
+	    break;
+	}
+	dir = aptr->preddir;
+	slot = aptr->predslot;
+	node = aptr->pred;
+    }
+    return firstbt;
+}
+
+/*--------------------------------------------------------------*/
+/* Levelized (graph-based) alternative to			*/
+/* find_clock_to_term_paths().  Instead of a depth-first search	*/
+/* from each launch point in turn, all launch points are seeded	*/
+/* at once and the worst arrival and transition times for each	*/
+/* edge direction are propagated through the timing graph in a	*/
+/* single forward sweep in topological order.  Arrival times	*/
+/* are offset by the clock skew of the launch point, so that	*/
+/* the launch point that produces the worst path to each	*/
+/* endpoint is retained.  With "depth" greater than 1, the	*/
+/* "depth" worst arrivals are kept at each node, which gives	*/
+/* the "depth" worst paths to each endpoint.  Delays are those	*/
+/* of process corner "cn".					*/
+/*								*/
+/* "analyses" holds the ANALYSIS() bit of each analysis type	*/
+/* to run.  When both are run, they share the one sweep and the	*/
+/* clock source tracing at each launch point.  The result of	*/
+/* each is left in lstate[minmax].				*/
+/*								*/
+/* If "part" is not NULL, only the launch points of that clock	*/
+/* domain are seeded, and only the nodes of its fanout cone are	*/
+/* swept (see find_clock_domains());  the arrivals at other	*/
+/* nodes are left undefined.  Launch points keep their index in	*/
+/* "clockedlist", so arrivals compare as in the full sweep.	*/
+/*--------------------------------------------------------------*/
+
+static void
+levelized_sweep(tgraph *graph, corner *cn, clocktree *clocks,
+		connlistptr clockedlist, partition *part, levelstate **lstate,
+		char analyses, int depth)
+{
+    arrival	*aptr;
+    launch	*lptr;
+    levelstate	*lst;
+    connlistptr testlink;
+    connptr	testconn;
+    btptr	clocklist, freebt;
+    double	skew;
+    short	dir, slot;
+    char	minmax;
+    int		numlaunch, numorder, i, j, k, node;
+    int		*order;
+    searchcount	counts;
+
+    memset(&counts, 0, sizeof(searchcount));
+    numlaunch = 0;
+    for (testlink = clockedlist; testlink; testlink = testlink->next)
+	numlaunch++;
+    order = (part) ? part->nodes : graph->order;
+    numorder = (part) ? part->numorder : graph->numorder;
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(analyses & ANALYSIS(minmax))) continue;
+	lst = lstate[minmax];
+	lst->corner = cn;
+	lst->clocks = clocks;
+	lst->depth = depth;
+	lst->merged = 0;
+	lst->numlaunch = numlaunch;
+	lst->launches = (launch *)calloc(numlaunch, sizeof(launch));
+	lst->arrivals = (arrival *)malloc(2 * depth * graph->numnodes * sizeof(arrival));
+	if (part == NULL) {
+	    for (i = 0; i < 2 * depth * graph->numnodes; i++) {
+		lst->arrivals[i].launch = -1;
+		lst->arrivals[i].bt = NULL;
+	    }
+	}
+	else {
+	    for (j = 0; j < part->numnodes; j++) {
+		aptr = NODE_ARRIVALS(lst, part->nodes[j], RISING);
+		for (i = 0; i < 2 * depth; i++) {
+		    aptr[i].launch = -1;
+		    aptr[i].bt = NULL;
+		}
+	    }
+	}
+	lst->launchidx = (int *)malloc(graph->numconns * sizeof(int));
+	for (i = 0; i < graph->numconns; i++)
+	    lst->launchidx[i] = -1;
+    }
+
+    // Seed the arrival times at the receivers driven by each launch point
+
+    for (i = 0, testlink = clockedlist; testlink; testlink = testlink->next, i++) {
+	if ((part != NULL) && (part->domain[i] != part->id)) continue;
+	testconn = testlink->connection;
+	clocklist = (analyses == BOTH_ANALYSES) ? find_launch_sources(testconn) : NULL;
+
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    if (!(analyses & ANALYSIS(minmax))) continue;
+	    lst = lstate[minmax];
+	    lptr = lst->launches + i;
+	    find_launch_data(clocks, testconn, lptr, clocklist, minmax);
+	    lst->launchidx[testconn->index] = i;
+	    skew = (lptr->source) ? lptr->source->delay : 0.0;
+
+	    levelized_propagate(graph, lst, lptr, testconn, lptr->dir,
+			-skew, lptr->trans, -1, 0, i, minmax);
+	}
+
+	while (clocklist != NULL) {
+	    freebt = clocklist;
+	    clocklist = clocklist->next;
+	    free(freebt);
+	}
+    }
+
+    // Forward sweep in topological order
+
+    for (k = 0; k < numorder; k++) {
+	node = order[k];
+	testconn = graph->nodes[node];
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    if (!(analyses & ANALYSIS(minmax))) continue;
+	    lst = lstate[minmax];
+	    for (dir = RISING; dir <= FALLING; dir++) {
+		aptr = NODE_ARRIVALS(lst, node, dir);
+		for (slot = 0; slot < depth; slot++, aptr++) {
+		    if (aptr->launch < 0) break;
+		    counts.visited++;
+		    levelized_propagate(graph, lst, lst->launches + aptr->launch,
+			testconn, dir, aptr->delay, aptr->trans, node, slot,
+			aptr->launch, minmax);
+		}
+	    }
+	}
+    }
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++)
+	if (analyses & ANALYSIS(minmax))
+	    lstate[minmax]->valid = 1;
+
+    profile_add_counts(&counts);
+}
+
+/*--------------------------------------------------------------*/
+/* Record the worst paths to each endpoint (up to the search	*/
+/* depth, for either edge direction) from the result of the	*/
+/* levelized search in "masterlist".  Paths are ranked as in	*/
+/* pathrank.  Backtraces are generated only for those paths,	*/
+/* in "pool".  Return value is the number of paths recorded.	*/
+/*--------------------------------------------------------------*/
+
+static int
+levelized_endpoints(tgraph *graph, levelstate *lstate, ddataptr *masterlist,
+		arena *pool, char minmax)
+{
+    arrival	*aptr;
+    launch	*lptr;
+    connptr	testconn;
+    ddataptr	newddata;
+    btptr	clock2list, selecteddest, freebt;
+    pathrank	*ranks, rank;
+    short	*pathslot, dir, slot;
+    int		numpaths, numcand, i, k, worst, node;
+
+    // Backtraces from any earlier call are gone with their pool.  Those
+    // of a merged result were made in "pool" by the domain threads.
+
+    if (!lstate->merged) {
+	for (i = 0; i < 2 * lstate->depth * graph->numnodes; i++)
+	    lstate->arrivals[i].bt = NULL;
+	for (i = 0; i < lstate->numlaunch; i++)
+	    lstate->launches[i].bt = NULL;
+    }
+
+    // Candidate arrivals of one endpoint, as the slot index over both
+    // directions (see NODE_ARRIVALS())
+
+    ranks = (pathrank *)malloc(2 * lstate->depth * sizeof(pathrank));
+    pathslot = (short *)malloc(2 * lstate->depth * sizeof(short));
+
+    numpaths = 0;
+    for (node = 0; node < graph->numnodes; node++) {
+	testconn = graph->nodes[node];
+	if (propagate_net(testconn) != NULL) continue;
+
+	aptr = NODE_ARRIVALS(lstate, node, RISING);
+	if ((aptr[0].launch < 0) && (aptr[lstate->depth].launch < 0)) continue;
+
+	selecteddest = find_capture_clock(lstate->clocks, testconn, &clock2list,
+			minmax);
+	numcand = 0;
+	for (i = 0; i < 2 * lstate->depth; i++) {
+	    if (aptr[i].launch < 0) continue;
+	    dir = (i < lstate->depth) ? RISING : FALLING;
+	    lptr = lstate->launches + aptr[i].launch;
+	    ranks[numcand].delay = capture_path_delay(lstate->corner, testconn, dir,
+			aptr[i].delay + ((lptr->source) ? lptr->source->delay : 0.0),
+			aptr[i].trans, lptr, clock2list, selecteddest, minmax,
+			&ranks[numcand].captured);
+	    pathslot[numcand++] = i;
+	}
+	while (clock2list != NULL) {
+	    freebt = clock2list;
+	    clock2list = clock2list->next;
+	    free(freebt);
+	}
+
+	// Record the worst paths, worst first
+
+	for (k = 0; (k < lstate->depth) && (k < numcand); k++) {
+	    worst = k;
+	    for (i = k + 1; i < numcand; i++)
+		if (rank_precedes(ranks + i, ranks + worst, minmax))
+		    worst = i;
+	    rank = ranks[worst];
+	    slot = pathslot[worst];
+	    for (i = worst; i > k; i--) {
+		ranks[i] = ranks[i - 1];
+		pathslot[i] = pathslot[i - 1];
+	    }
+	    ranks[k] = rank;
+	    pathslot[k] = slot;
+
+	    dir = (slot < lstate->depth) ? RISING : FALLING;
+	    lptr = lstate->launches + aptr[slot].launch;
+
+	    numpaths++;
+	    newddata = (ddataptr)arena_alloc(pool, sizeof(delaydata));
+	    newddata->delay = 0.0;
+	    newddata->trans = 0.0;
+	    newddata->backtrace = levelized_backtrace(graph, lstate, node, dir,
+			slot % lstate->depth, pool);
+	    newddata->next = *masterlist;
+	    *masterlist = newddata;
+
+	    terminate_path(lstate->corner, lstate->clocks, newddata, lptr->conn,
+			lptr->clocklist, lptr->source, minmax);
+	}
+    }
+    free(ranks);
+    free(pathslot);
+
+    if (verbose > 0)
+	fprintf(stdout, "%d paths traced from %d launch points.\n\n", numpaths,
+			lstate->numlaunch);
+
+    return numpaths;
+}
+
+/*--------------------------------------------------------------*/
+/* Free the result of a levelized search			*/
+/*--------------------------------------------------------------*/
+
+static void
+free_level_state(levelstate *lstate)
+{
+    btptr freebt;
+    int i;
+
+    if (!lstate->valid) return;
+
+    // Free up clocklists
+
+    for (i = 0; i < lstate->numlaunch; i++) {
+	while (lstate->launches[i].clocklist != NULL) {
+	    freebt = lstate->launches[i].clocklist;
+	    lstate->launches[i].clocklist = lstate->launches[i].clocklist->next;
+	    free(freebt);
+	}
+    }
+    free(lstate->launches);
+    free(lstate->launchidx);
+    free(lstate->arrivals);
+    lstate->valid = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the arrival slots of graph node "node" from the	*/
+/* arrivals at its fanin nodes and from any launch points	*/
+/* driving it, leaving the result in "result" (the rising	*/
+/* slots, then the falling slots).  This is the same set of	*/
+/* arrivals that the forward sweep of levelized_sweep() would	*/
+/* compare at "node".						*/
+/*--------------------------------------------------------------*/
+
+static void
+levelized_evaluate(tgraph *graph, levelstate *lstate, int node, arrival *result,
+		char minmax)
+{
+    arrival *aptr;
+    launch  *lptr;
+    double  newdelay[2], newtrans[2], skew;
+    short   outdir, dir, slot;
+    int	    i, src, idx, depth;
+
+    depth = lstate->depth;
+    for (i = 0; i < 2 * depth; i++) {
+	result[i].launch = -1;
+	result[i].bt = NULL;
+    }
+
+    for (i = graph->instart[node]; i < graph->instart[node + 1]; i++) {
+	src = graph->inarcs[i];
+
+	idx = lstate->launchidx[src];
+	if (idx >= 0) {
+	    lptr = lstate->launches + idx;
+	    if (node != lptr->conn->index) {
+		skew = (lptr->source) ? lptr->source->delay : 0.0;
+		outdir = levelized_gate_output(lstate->corner, lptr->conn, lptr->dir,
+			-skew, lptr->trans, minmax, newdelay, newtrans);
+		if (outdir & RISING)
+		    update_arrival(result, depth, newdelay[0], newtrans[0], -1,
+				lptr->dir, 0, idx, minmax);
+		if (outdir & FALLING)
+		    update_arrival(result + depth, depth, newdelay[1], newtrans[1], -1,
+				lptr->dir, 0, idx, minmax);
+	    }
+	}
+
+	// Only propagating nodes contribute.  Endpoints and module
+	// inputs do not propagate.
+
+	if (src >= graph->numnodes) continue;
+	if (graph->pos[src] >= graph->numorder) continue;
+
+	for (dir = RISING; dir <= FALLING; dir++) {
+	    aptr = NODE_ARRIVALS(lstate, src, dir);
+	    for (slot = 0; slot < depth; slot++, aptr++) {
+		if (aptr->launch < 0) break;
+		if (node == lstate->launches[aptr->launch].conn->index) continue;
+		outdir = levelized_gate_output(lstate->corner, graph->nodes[src], dir,
+			aptr->delay, aptr->trans, minmax, newdelay, newtrans);
+		if (outdir & RISING)
+		    update_arrival(result, depth, newdelay[0], newtrans[0], src, dir,
+			slot, aptr->launch, minmax);
+		if (outdir & FALLING)
+		    update_arrival(result + depth, depth, newdelay[1], newtrans[1], src,
+			dir, slot, aptr->launch, minmax);
+	    }
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Return 1 if two arrival records differ			*/
+/*--------------------------------------------------------------*/
+
+static int
+arrival_differs(arrival *a, arrival *b)
+{
+    if (a->launch != b->launch) return 1;
+    if (a->launch < 0) return 0;
+    return ((a->delay != b->delay) || (a->trans != b->trans) ||
+		(a->pred != b->pred) || (a->preddir != b->preddir) ||
+		(a->predslot != b->predslot));
+}
+
+/*--------------------------------------------------------------*/
+/* Add graph node "node" to the heap of nodes to be updated,	*/
+/* which is ordered by position in the topological order.	*/
+/*--------------------------------------------------------------*/
+
+static void
+update_heap_push(tgraph *graph, int *heap, int *numheap, char *queued, int node)
+{
+    int i, parent;
+
+    if (queued[node]) return;
+    queued[node] = 1;
+
+    i = (*numheap)++;
+    while (i > 0) {
+	parent = (i - 1) / 2;
+	if (graph->pos[heap[parent]] < graph->pos[node]) break;
+	if ((graph->pos[heap[parent]] == graph->pos[node]) && (heap[parent] < node))
+	    break;
+	heap[i] = heap[parent];
+	i = parent;
+    }
+    heap[i] = node;
+}
+
+/*--------------------------------------------------------------*/
+/* Remove and return the first node in the update heap		*/
+/*--------------------------------------------------------------*/
+
+static int
+update_heap_pop(tgraph *graph, int *heap, int *numheap)
+{
+    int i, child, node, last;
+
+    node = heap[0];
+    last = heap[--(*numheap)];
+    i = 0;
+    while ((child = 2 * i + 1) < *numheap) {
+	if ((child + 1 < *numheap) &&
+		((graph->pos[heap[child + 1]] < graph->pos[heap[child]]) ||
+		((graph->pos[heap[child + 1]] == graph->pos[heap[child]]) &&
+		(heap[child + 1] < heap[child]))))
+	    child++;
+	if ((graph->pos[last] < graph->pos[heap[child]]) ||
+		((graph->pos[last] == graph->pos[heap[child]]) &&
+		(last < heap[child])))
+	    break;
+	heap[i] = heap[child];
+	i = child;
+    }
+    heap[i] = last;
+    return node;
+}
+
+/*--------------------------------------------------------------*/
+/* Incrementally update the result of a levelized search after	*/
+/* a change to the design.  "dirty" lists the "numdirty" graph	*/
+/* nodes whose incoming arcs may have changed (new delays, or	*/
+/* new fanin).  The launch points are checked for changes in	*/
+/* clock skew or transition time, then the changed nodes are	*/
+/* evaluated again in topological order, and changes are	*/
+/* propagated forward only as far as the arrival times		*/
+/* actually change.  Because update_arrival() does not depend	*/
+/* on the order of evaluation, the result is identical to that	*/
+/* of levelized_sweep().  Return the number of nodes evaluated.	*/
+/*--------------------------------------------------------------*/
+
+static int
+levelized_update(tgraph *graph, levelstate *lstate, int *dirty, int numdirty,
+		char minmax)
+{
+    launch	*lptr, newlaunch;
+    arrival	*result, *aptr;
+    btptr	freebt, clockbt;
+    double	oldskew, newskew;
+    char	*queued;
+    int		*heap, numheap, numevals, i, node, depth;
+
+    depth = lstate->depth;
+    result = (arrival *)malloc(2 * depth * sizeof(arrival));
+    heap = (int *)malloc(graph->numnodes * sizeof(int));
+    queued = (char *)calloc(graph->numnodes, sizeof(char));
+    numheap = 0;
+
+    for (i = 0; i < numdirty; i++)
+	update_heap_push(graph, heap, &numheap, queued, dirty[i]);
+
+    // Changes in the clock network move the launch points.  Only the
+    // launch points with a changed receiver in their clock tree are
+    // found again.
+
+    for (i = 0; i < lstate->numlaunch; i++) {
+	lptr = lstate->launches + i;
+	for (clockbt = lptr->clocklist; clockbt; clockbt = clockbt->next) {
+	    node = clockbt->receiver->index;
+	    if ((node >= 0) && (node < graph->numnodes) && queued[node]
+			&& (graph->nodes[node] == clockbt->receiver))
+		break;
+	}
+	if (clockbt == NULL) continue;
+
+	find_launch_data(lstate->clocks, lptr->conn, &newlaunch, NULL, minmax);
+	oldskew = (lptr->source) ? lptr->source->delay : 0.0;
+	newskew = (newlaunch.source) ? newlaunch.source->delay : 0.0;
+	if ((newlaunch.dir != lptr->dir) || (newlaunch.trans != lptr->trans)
+			|| (newskew != oldskew)) {
+	    for (node = graph->arcstart[lptr->conn->index];
+			node < graph->arcstart[lptr->conn->index + 1]; node++)
+		update_heap_push(graph, heap, &numheap, queued, graph->arcs[node]);
+	}
+	while (lptr->clocklist != NULL) {
+	    freebt = lptr->clocklist;
+	    lptr->clocklist = lptr->clocklist->next;
+	    free(freebt);
+	}
+	*lptr = newlaunch;
+    }
+
+    numevals = 0;
+    while (numheap > 0) {
+	node = update_heap_pop(graph, heap, &numheap);
+	numevals++;
+
+	levelized_evaluate(graph, lstate, node, result, minmax);
+	aptr = NODE_ARRIVALS(lstate, node, RISING);
+	for (i = 0; i < 2 * depth; i++)
+	    if (arrival_differs(aptr + i, result + i)) break;
+	if (i == 2 * depth) continue;
+	memcpy(aptr, result, 2 * depth * sizeof(arrival));
+
+	// Endpoints have nothing downstream
+	if (graph->pos[node] >= graph->numorder) continue;
+
+	for (i = graph->arcstart[node]; i < graph->arcstart[node + 1]; i++)
+	    if (graph->pos[graph->arcs[i]] > graph->pos[node])
+		update_heap_push(graph, heap, &numheap, queued, graph->arcs[i]);
+    }
+
+    free(result);
+    free(heap);
+    free(queued);
+    return numevals;
+}
+
+/*--------------------------------------------------------------*/
+/* Move the result of a levelized search from "oldgraph" to	*/
+/* "graph", a new timing graph built from the same design after	*/
+/* a change in connectivity.  Nodes are matched by connection	*/
+/* record.  Nodes new to the graph have no arrival, and must be	*/
+/* passed to levelized_update().				*/
+/*--------------------------------------------------------------*/
+
+static void
+remap_level_state(levelstate *lstate, tgraph *oldgraph, tgraph *graph)
+{
+    arrival *arrivals, *aptr;
+    int	    i, old, node, nslots;
+
+    nslots = 2 * lstate->depth;
+    arrivals = (arrival *)malloc(nslots * graph->numnodes * sizeof(arrival));
+    for (i = 0; i < nslots * graph->numnodes; i++) {
+	arrivals[i].launch = -1;
+	arrivals[i].bt = NULL;
+    }
+
+    for (old = 0; old < oldgraph->numnodes; old++) {
+	node = oldgraph->nodes[old]->index;
+	if ((node < 0) || (node >= graph->numnodes)) continue;
+	if (graph->nodes[node] != oldgraph->nodes[old]) continue;
+	for (i = 0; i < nslots; i++) {
+	    aptr = arrivals + nslots * node + i;
+	    *aptr = lstate->arrivals[nslots * old + i];
+	    aptr->bt = NULL;
+	    if ((aptr->launch >= 0) && (aptr->pred >= 0))
+		aptr->pred = oldgraph->nodes[aptr->pred]->index;
+	}
+    }
+    free(lstate->arrivals);
+    lstate->arrivals = arrivals;
+
+    free(lstate->launchidx);
+    lstate->launchidx = (int *)malloc(graph->numconns * sizeof(int));
+    for (i = 0; i < graph->numconns; i++)
+	lstate->launchidx[i] = -1;
+    for (i = 0; i < lstate->numlaunch; i++)
+	lstate->launchidx[lstate->launches[i].conn->index] = i;
+}
+
+/*--------------------------------------------------------------*/
+/* Free the clock domains found by find_clock_domains()		*/
+/*--------------------------------------------------------------*/
+
+static void
+free_clock_domains(partition *parts, int numparts)
+{
+    int i;
+
+    for (i = 0; i < numparts; i++) {
+	free(parts[i].nodes);
+	if (parts[i].ends[MINIMUM_TIME]) free(parts[i].ends[MINIMUM_TIME]);
+	if (parts[i].ends[MAXIMUM_TIME]) free(parts[i].ends[MAXIMUM_TIME]);
+    }
+    free(parts[0].domain);
+    free(parts);
+}
+
+/*--------------------------------------------------------------*/
+/* Return the root of set "i" in the union-find forest		*/
+/* "parent", shortening the path to it on the way.		*/
+/*--------------------------------------------------------------*/
+
+static int
+domain_root(int *parent, int i)
+{
+    int root, next;
+
+    for (root = i; parent[root] != root; root = parent[root]);
+    while (i != root) {
+	next = parent[i];
+	parent[i] = root;
+	i = next;
+    }
+    return root;
+}
+
+/*--------------------------------------------------------------*/
+/* Partition the launch points at register clocks in		*/
+/* "clockedlist" into clock domains.  Two launch points are in	*/
+/* the same domain if their clocks have a net in common (as	*/
+/* found by find_common_clock()), which is so exactly when they	*/
+/* have a clock source (a module input or flop output) in	*/
+/* common, so the domains are the sets of launch points joined	*/
+/* through shared clock sources.  Each domain gets the fanout	*/
+/* cone of its launch points in the timing graph:  the		*/
+/* propagating nodes in topological order, then the endpoints.	*/
+/* The cones of different domains overlap where paths cross	*/
+/* from one domain to another.					*/
+/*								*/
+/* Return the domains, and their number in "numparts".  If	*/
+/* there are fewer than two, return NULL.			*/
+/*--------------------------------------------------------------*/
+
+static partition *
+find_clock_domains(tgraph *graph, connlistptr clockedlist, int *numparts)
+{
+    partition	*parts, *part;
+    connlistptr testlink;
+    connptr	driver;
+    netptr	*sources;
+    btptr	clocklist, testbt;
+    int		*parent, *domain, *launchsrc, *ids, *mark, *cone;
+    int		numlaunch, numsources, maxsources, numcone, numends;
+    int		i, j, k, d, node, first;
+
+    numlaunch = 0;
+    for (testlink = clockedlist; testlink; testlink = testlink->next)
+	numlaunch++;
+
+    // Join the clock sources of each launch point into one set
+
+    sources = NULL;
+    parent = NULL;
+    numsources = maxsources = 0;
+    launchsrc = (int *)malloc(numlaunch * sizeof(int));
+    for (i = 0, testlink = clockedlist; testlink; testlink = testlink->next, i++) {
+	clocklist = find_launch_sources(testlink->connection);
+	first = -1;
+	while (clocklist != NULL) {
+	    testbt = clocklist;
+	    clocklist = clocklist->next;
+
+	    // Clock sources are where find_clock_source() stops
+
+	    driver = testbt->receiver->refnet->driver;
+	    if ((driver == NULL) || (driver->refinst == NULL) ||
+			(driver->refpin->type & DFFOUT) ||
+			(driver->refinst->in_connects == NULL)) {
+		for (j = 0; j < numsources; j++)
+		    if (sources[j] == testbt->receiver->refnet) break;
+		if (j == numsources) {
+		    if (numsources == maxsources) {
+			maxsources = (maxsources) ? 2 * maxsources : 16;
+			sources = (netptr *)realloc(sources, maxsources * sizeof(netptr));
+			parent = (int *)realloc(parent, maxsources * sizeof(int));
+		    }
+		    sources[j] = testbt->receiver->refnet;
+		    parent[j] = j;
+		    numsources++;
+		}
+		if (first < 0)
+		    first = j;
+		else
+		    parent[domain_root(parent, j)] = domain_root(parent, first);
+	    }
+	    free(testbt);
+	}
+	launchsrc[i] = first;
+    }
+
+    // Number the domains in the order of their first launch point.  A
+    // launch point with no clock source is a domain by itself.
+
+    domain = (int *)malloc(numlaunch * sizeof(int));
+    ids = (int *)malloc((numsources + 1) * sizeof(int));
+    for (j = 0; j < numsources; j++)
+	ids[j] = -1;
+    *numparts = 0;
+    for (i = 0; i < numlaunch; i++) {
+	if (launchsrc[i] < 0) {
+	    domain[i] = (*numparts)++;
+	    continue;
+	}
+	j = domain_root(parent, launchsrc[i]);
+	if (ids[j] < 0) ids[j] = (*numparts)++;
+	domain[i] = ids[j];
+    }
+    free(ids);
+    free(launchsrc);
+    free(parent);
+    free(sources);
+
+    if (*numparts < 2) {
+	free(domain);
+	return NULL;
+    }
+
+    // Find the fanout cone of each domain
+
+    parts = (partition *)malloc(*numparts * sizeof(partition));
+    mark = (int *)malloc(graph->numnodes * sizeof(int));
+    for (node = 0; node < graph->numnodes; node++)
+	mark[node] = -1;
+    cone = (int *)malloc(graph->numnodes * sizeof(int));
+
+    for (d = 0; d < *numparts; d++) {
+	part = parts + d;
+	part->id = d;
+	part->domain = domain;
+	part->ends[MINIMUM_TIME] = part->ends[MAXIMUM_TIME] = NULL;
+
+	numcone = numends = 0;
+	for (i = 0, testlink = clockedlist; testlink; testlink = testlink->next, i++) {
+	    if (domain[i] != d) continue;
+	    node = testlink->connection->index;
+	    for (k = graph->arcstart[node]; k < graph->arcstart[node + 1]; k++) {
+		if (mark[graph->arcs[k]] == d) continue;
+		mark[graph->arcs[k]] = d;
+		cone[numcone++] = graph->arcs[k];
+	    }
+	}
+	for (j = 0; j < numcone; j++) {
+	    node = cone[j];
+	    if (propagate_net(graph->nodes[node]) == NULL) {
+		numends++;
+		continue;
+	    }
+	    for (k = graph->arcstart[node]; k < graph->arcstart[node + 1]; k++) {
+		if (mark[graph->arcs[k]] == d) continue;
+		mark[graph->arcs[k]] = d;
+		cone[numcone++] = graph->arcs[k];
+	    }
+	}
+
+	part->numnodes = numcone;
+	part->numorder = numcone - numends;
+	part->nodes = (int *)malloc(numcone * sizeof(int));
+	for (j = 0, k = 0; k < graph->numorder; k++)
+	    if (mark[graph->order[k]] == d)
+		part->nodes[j++] = graph->order[k];
+	for (k = 0; k < numcone; k++)
+	    if (propagate_net(graph->nodes[cone[k]]) == NULL)
+		part->nodes[j++] = cone[k];
+    }
+    free(cone);
+    free(mark);
+    return parts;
+}
+
+/*--------------------------------------------------------------*/
+/* Run the levelized search over one clock domain "part",	*/
+/* generate the backtraces of every arrival at the endpoints	*/
+/* of its cone in pool[minmax], and keep those arrivals in	*/
+/* part->ends[minmax].  The launch point records are moved to	*/
+/* the merged result in search->lstate, at the same index.	*/
+/*--------------------------------------------------------------*/
+
+static void
+domain_sweep(domainsearch *search, partition *part, arena *pool)
+{
+    levelstate	state[2], *lstate[2], *lst;
+    arrival	*aptr;
+    short	dir, slot;
+    char	minmax;
+    int		depth, numends, i, j, node;
+
+    depth = search->depth;
+    lstate[MINIMUM_TIME] = &state[MINIMUM_TIME];
+    lstate[MAXIMUM_TIME] = &state[MAXIMUM_TIME];
+    levelized_sweep(search->graph, search->corner, search->clocks,
+		search->clockedlist, part, lstate, search->analyses, depth);
+
+    numends = part->numnodes - part->numorder;
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(search->analyses & ANALYSIS(minmax))) continue;
+	lst = lstate[minmax];
+	part->ends[minmax] = (arrival *)malloc(2 * depth * numends * sizeof(arrival));
+	for (j = 0; j < numends; j++) {
+	    node = part->nodes[part->numorder + j];
+	    for (dir = RISING; dir <= FALLING; dir++) {
+		aptr = NODE_ARRIVALS(lst, node, dir);
+		for (slot = 0; (slot < depth) && (aptr[slot].launch >= 0); slot++)
+		    levelized_backtrace(search->graph, lst, node, dir, slot,
+				pool + minmax);
+	    }
+	    memcpy(part->ends[minmax] + 2 * depth * j, NODE_ARRIVALS(lst, node, RISING),
+			2 * depth * sizeof(arrival));
+	}
+
+	for (i = 0; i < lst->numlaunch; i++) {
+	    if (part->domain[i] != part->id) continue;
+	    search->lstate[minmax]->launches[i] = lst->launches[i];
+	    lst->launches[i].clocklist = NULL;
+	}
+	free_level_state(lst);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Main routine of a domain search thread.			*/
+/*--------------------------------------------------------------*/
+
+static void *
+domain_search_thread(void *arg)
+{
+    domainthread *thread = (domainthread *)arg;
+    domainsearch *search = thread->search;
+    int		 idx;
+
+    while (1) {
+	pthread_mutex_lock(&search->lock);
+	idx = search->next++;
+	pthread_mutex_unlock(&search->lock);
+	if (idx >= search->numparts) break;
+	domain_sweep(search, search->parts + idx, thread->pool);
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Levelized search (see levelized_sweep()) over the clock	*/
+/* domains "parts" found by find_clock_domains(), with each	*/
+/* domain swept on its own by one of "numthreads" threads.	*/
+/* The arrivals at the endpoints of all domains are then	*/
+/* merged into lstate[minmax], keeping the first by path rank	*/
+/* (see pathrank), so that paths crossing from one domain to	*/
+/* another, which no setup or hold check applies to, are kept	*/
+/* at an endpoint only if too few paths of a domain that	*/
+/* captures it arrive there.  The backtraces of the merged	*/
+/* arrivals are made already, in pool[minmax], and only the	*/
+/* endpoint arrivals are defined.				*/
+/*--------------------------------------------------------------*/
+
+static void
+levelized_domain_search(tgraph *graph, corner *cn, clocktree *clocks,
+		connlistptr clockedlist, partition *parts, int numparts,
+		levelstate **lstate, arena **pool, char analyses, int depth)
+{
+    domainsearch search;
+    domainthread *threads;
+    pthread_t	*tids;
+    connlistptr testlink;
+    levelstate	*lst;
+    partition	*part;
+    arrival	*aptr;
+    launch	*lptr;
+    connptr	testconn;
+    btptr	clock2list, selecteddest, freebt;
+    pathrank	*ranks, rank;
+    short	dir, slot;
+    char	minmax;
+    int		nthreads, numlaunch, numends, i, j, node;
+
+    numlaunch = 0;
+    for (testlink = clockedlist; testlink; testlink = testlink->next)
+	numlaunch++;
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(analyses & ANALYSIS(minmax))) continue;
+	lst = lstate[minmax];
+	lst->corner = cn;
+	lst->clocks = clocks;
+	lst->depth = depth;
+	lst->merged = 1;
+	lst->numlaunch = numlaunch;
+	lst->launches = (launch *)calloc(numlaunch, sizeof(launch));
+	lst->arrivals = (arrival *)malloc(2 * depth * graph->numnodes * sizeof(arrival));
+	for (i = 0; i < 2 * depth * graph->numnodes; i++) {
+	    lst->arrivals[i].launch = -1;
+	    lst->arrivals[i].bt = NULL;
+	}
+	lst->launchidx = (int *)malloc(graph->numconns * sizeof(int));
+	for (i = 0; i < graph->numconns; i++)
+	    lst->launchidx[i] = -1;
+	for (i = 0, testlink = clockedlist; testlink; testlink = testlink->next, i++)
+	    lst->launchidx[testlink->connection->index] = i;
+    }
+
+    search.graph = graph;
+    search.corner = cn;
+    search.clocks = clocks;
+    search.clockedlist = clockedlist;
+    search.parts = parts;
+    search.numparts = numparts;
+    search.next = 0;
+    search.lstate = lstate;
+    search.analyses = analyses;
+    search.depth = depth;
+    pthread_mutex_init(&search.lock, NULL);
+
+    nthreads = (numthreads < numparts) ? numthreads : numparts;
+    if (verbose > 0)
+	fprintf(stdout, "Searching %d clock domains on %d threads.\n", numparts,
+			nthreads);
+    threads = (domainthread *)malloc(nthreads * sizeof(domainthread));
+    tids = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    for (i = 0; i < nthreads; i++) {
+	threads[i].search = &search;
+	arena_init(&threads[i].pool[MINIMUM_TIME]);
+	arena_init(&threads[i].pool[MAXIMUM_TIME]);
+    }
+    for (i = 0; i < nthreads; i++)
+	pthread_create(&tids[i], NULL, domain_search_thread, &threads[i]);
+    for (i = 0; i < nthreads; i++) {
+	pthread_join(tids[i], NULL);
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    if (!(analyses & ANALYSIS(minmax))) continue;
+	    arena_merge(pool[minmax], &threads[i].pool[minmax]);
+	    arena_free(&threads[i].pool[minmax]);
+	}
+    }
+    pthread_mutex_destroy(&search.lock);
+    free(threads);
+    free(tids);
+
+    // Merge the endpoint arrivals of the domains by path rank, so that
+    // the paths kept at an endpoint are those that its clock captures
+    // whenever there are any
+
+    ranks = (pathrank *)malloc(2 * depth * graph->numnodes * sizeof(pathrank));
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(analyses & ANALYSIS(minmax))) continue;
+	lst = lstate[minmax];
+	for (i = 0; i < numparts; i++) {
+	    part = parts + i;
+	    numends = part->numnodes - part->numorder;
+	    for (j = 0; j < numends; j++) {
+		node = part->nodes[part->numorder + j];
+		testconn = graph->nodes[node];
+		selecteddest = find_capture_clock(clocks, testconn, &clock2list, minmax);
+		for (dir = RISING; dir <= FALLING; dir++) {
+		    aptr = part->ends[minmax] + (2 * j + dir - 1) * depth;
+		    for (slot = 0; (slot < depth) && (aptr[slot].launch >= 0); slot++) {
+			lptr = lst->launches + aptr[slot].launch;
+			rank.delay = capture_path_delay(cn, testconn, dir,
+				aptr[slot].delay + ((lptr->source) ?
+				lptr->source->delay : 0.0), aptr[slot].trans, lptr,
+				clock2list, selecteddest, minmax, &rank.captured);
+			insert_ranked_arrival(NODE_ARRIVALS(lst, node, dir),
+				ranks + (2 * node + dir - 1) * depth, depth,
+				aptr + slot, &rank, minmax);
+		    }
+		}
+		while (clock2list != NULL) {
+		    freebt = clock2list;
+		    clock2list = clock2list->next;
+		    free(freebt);
+		}
+	    }
+	    free(part->ends[minmax]);
+	    part->ends[minmax] = NULL;
+	}
+    }
+    free(ranks);
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++)
+	if (analyses & ANALYSIS(minmax))
+	    lstate[minmax]->valid = 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Parse a table variable type from a liberty format file	*/
+/*--------------------------------------------------------------*/
+
+static int get_table_type(char *token) {
+    if (!strcasecmp(token, "input_net_transition"))
+	return TRANSITION_TIME;
+    else if (!strcasecmp(token, "total_output_net_capacitance"))
+	return OUTPUT_CAP;
+    else if (!strcasecmp(token, "related_pin_transition"))
+	return RELATED_TIME;
+    else if (!strcasecmp(token, "constrained_pin_transition"))
+	return CONSTRAINED_TIME;
+    else
+	return UNKNOWN;
+}
+
+/*--------------------------------------------------------------*/
+/* Free a lookup table read by libertyRead().			*/
+/*--------------------------------------------------------------*/
+
+static void
+free_table(lutable *tableptr)
+{
+    if (tableptr == NULL) return;
+    free(tableptr->name);
+    free(tableptr->idx1.times);
+    free(tableptr->idx2.caps);
+    free(tableptr->values);
+    free(tableptr);
+}
+
+/*--------------------------------------------------------------*/
+/* Free the table templates "tables" and the cells "cells" of	*/
+/* a library read by libertyRead(), before its tables are	*/
+/* given shared index arrays (see share_table_indexes()).	*/
+/*--------------------------------------------------------------*/
+
+static void
+free_library(lutable *tables, cell *cells)
+{
+    lutable *nexttable;
+    cell *nextcell;
+    pin *testpin, *nextpin;
+
+    for (; tables; tables = nexttable) {
+	nexttable = tables->next;
+	free_table(tables);
+    }
+    for (; cells; cells = nextcell) {
+	nextcell = cells->next;
+	for (testpin = cells->pins; testpin; testpin = nextpin) {
+	    nextpin = testpin->next;
+	    free_table(testpin->propdelr);
+	    free_table(testpin->propdelf);
+	    free_table(testpin->transr);
+	    free_table(testpin->transf);
+	    free(testpin->name);
+	    free(testpin);
+	}
+	free(cells->name);
+	free(cells->function);
+	free(cells);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Read a liberty format file and collect information about	*/
+/* the timing properties of each standard cell.  Progress is	*/
+/* reported to "log" (if not NULL).  Return 0 on success, or -1	*/
+/* if the file is not a library that can be read, or if it is	*/
+/* compressed and ends early (flib->error is then set).  On	*/
+/* error, the part of the library read is freed.		*/
+/*--------------------------------------------------------------*/
+
+static int
+libertyRead(tokenstream *flib, lutable **tablelist, cell **celllist, FILE *log)
+{
+    char *token;
+    int section = INIT;
+
+    double time_unit = 1.0;	// Time unit multiplier, to get ps
+    double cap_unit = 1.0;	// Capacitive unit multiplier, to get fF
+
+    pinptr testpin;
+    lutable *tableptr;
+
+    int i, j;
+    double gval;
+    char *iptr;
+    short timing_type, sense_type;
+
+    lutable *newtable, *reftable;
+    cell *newcell, *lastcell;
+    pin *newpin;
+
+    hashtable templates;
+    jmp_buf onerror;
+
+    lastcell = NULL;
+    timing_type = UNKNOWN;
+    hash_init(&templates, 64, 0);
+
+    // Compressed input that ends early ends the parse here
+
+    flib->onerror = &onerror;
+    if (setjmp(onerror) != 0) {
+	flib->onerror = NULL;
+	hash_free(&templates);
+	free_library(*tablelist, *celllist);
+	*tablelist = NULL;
+	*celllist = NULL;
+	return -1;
+    }
+
+    /* Read tokens off of the line */
+    token = advancetoken(flib, 0);
+
+    while (token != NULL) {
+
+	switch (section) {
+	    case INIT:
+		if (!strcasecmp(token, "library")) {
+		    token = advancetoken(flib, 0);
+		    if (strcmp(token, "("))
+			fprintf(stderr, "Library not followed by name\n");
+		    else
+			token = advancetoken(flib, ')');
+		    if (log != NULL)
+			fprintf(log, "Parsing library \"%s\"\n", token);
+		    token = advancetoken(flib, 0);
+		    if (strcmp(token, "{")) {
+			fprintf(stderr, "Did not find opening brace "
+					"on library block\n");
+			longjmp(onerror, 1);
+		    }
+		    section = LIBBLOCK;
+		}
+		else
+		    fprintf(stderr, "Unknown input \"%s\", looking for "
+					"\"library\"\n", token);
+		break;
+
+	    case LIBBLOCK:
+		// Here we check for the main blocks, again not rigorously. . .
+
+		if (!strcasecmp(token, "}")) {
+		    if (log != NULL)
+			fprintf(log, "End of library at line %d\n", flib->line);
+		    section = INIT;			// End of library block
+		}
+		else if (!strcasecmp(token, "delay_model")) {
+		    token = advancetoken(flib, 0);
+		    if (strcmp(token, ":"))
+			fprintf(stderr, "Input missing colon\n");
+		    token = advancetoken(flib, ';');
+		    if (strcasecmp(token, "table_lookup")) {
+			fprintf(stderr, "Sorry, only know how to "
+					"handle table lookup!\n");
+			longjmp(onerror, 1);
+		    }
+		}
+		else if (!strcasecmp(token, "lu_table_template") ||
+			 !strcasecmp(token, "power_lut_template")) {
+		    // Read in template information;
+		    newtable = (lutable *)malloc(sizeof(lutable));
+		    newtable->name = NULL;
+		    newtable->invert = 0;
+		    newtable->var1 = UNKNOWN;
+		    newtable->var2 = UNKNOWN;
+		    newtable->size1 = 0;
+		    newtable->size2 = 0;
+		    newtable->idx1.times = NULL;
+		    newtable->idx2.caps = NULL;
+		    newtable->values = NULL;
+		    newtable->next = *tablelist;
+		    *tablelist = newtable;
+
+		    token = advancetoken(flib, 0);
+		    if (strcmp(token, "("))
+			fprintf(stderr, "Input missing open parens\n");
+		    else
+			token = advancetoken(flib, ')');
+		    newtable->name = strdup(token);
+		    hash_insert(&templates, newtable->name, NULL, newtable);
+		    while (*token != '}') {
+			token = advancetoken(flib, 0);
+			if (!strcasecmp(token, "variable_1")) {
+			    token = advancetoken(flib, 0);
+			    token = advancetoken(flib, ';');
+			    newtable->var1 = get_table_type(token);
+			    if (newtable->var1 == OUTPUT_CAP || newtable->var1 == CONSTRAINED_TIME)
+				newtable->invert = 1;
+			}
+			else if (!strcasecmp(token, "variable_2")) {
+			    token = advancetoken(flib, 0);
+			    token = advancetoken(flib, ';');
+			    newtable->var2 = get_table_type(token);
+			    if (newtable->var2 == TRANSITION_TIME || newtable->var2 == RELATED_TIME)
+				newtable->invert = 1;
+			}
+			else if (!strcasecmp(token, "index_1")) {
+			    token = advancetoken(flib, 0);	// Open parens
+			    token = advancetoken(flib, 0);	// Quote
+			    if (!strcmp(token, "\""))
+				token = advancetoken(flib, '\"');
+
+			    if (newtable->invert == 1) {
+				// Count entries
+				iptr = token;
+				newtable->size2 = 1;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size2++;
+				}
+				newtable->idx2.caps = (double *)malloc(newtable->size2 *
+					sizeof(double));
+				newtable->size2 = 0;
+				iptr = token;
+				sscanf(iptr, "%lg", &newtable->idx2.caps[0]);
+				if (newtable->var2 == OUTPUT_CAP)
+				    newtable->idx2.caps[0] *= cap_unit;
+				else
+				    newtable->idx2.caps[0] *= time_unit;
+
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size2++;
+				    sscanf(iptr, "%lg",
+						&newtable->idx2.caps[newtable->size2]);
+				    if (newtable->var2 == OUTPUT_CAP)
+					newtable->idx2.caps[newtable->size2] *= cap_unit;
+				    else
+					newtable->idx2.cons[newtable->size2] *= time_unit;
+				}
+				newtable->size2++;
+			    }
+			    else {	// newtable->invert = 0
+				// Count entries
+				iptr = token;
+				newtable->size1 = 1;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size1++;
+				}
+				newtable->idx1.times = (double *)malloc(newtable->size1 *
+					sizeof(double));
+				newtable->size1 = 0;
+				iptr = token;
+				sscanf(iptr, "%lg", &newtable->idx1.times[0]);
+				newtable->idx1.times[0] *= time_unit; 
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size1++;
+				    sscanf(iptr, "%lg",
+						&newtable->idx1.times[newtable->size1]);
+				    newtable->idx1.times[newtable->size1] *= time_unit;
+				}
+				newtable->size1++;
+			    }
+
+			    token = advancetoken(flib, ';'); // EOL semicolon
+			}
+			else if (!strcasecmp(token, "index_2")) {
+			    token = advancetoken(flib, 0);	// Open parens
+			    token = advancetoken(flib, 0);	// Quote
+			    if (!strcmp(token, "\""))
+				token = advancetoken(flib, '\"');
+
+			    if (newtable->invert == 0) {
+				// Count entries
+				iptr = token;
+				newtable->size2 = 1;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size2++;
+				}
+				newtable->idx2.caps = (double *)malloc(newtable->size2 *
+					sizeof(double));
+				newtable->size2 = 0;
+				iptr = token;
+				sscanf(iptr, "%lg", &newtable->idx2.caps[0]);
+				if (newtable->var2 == OUTPUT_CAP)
+				    newtable->idx2.caps[0] *= cap_unit;
+				else
+				    newtable->idx2.cons[0] *= time_unit;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size2++;
+				    sscanf(iptr, "%lg",
+						&newtable->idx2.caps[newtable->size2]);
+				    if (newtable->var2 == OUTPUT_CAP)
+					newtable->idx2.caps[newtable->size2] *= cap_unit;
+				    else
+					newtable->idx2.cons[newtable->size2] *= time_unit;
+				}
+				newtable->size2++;
+			    }
+			    else { 	// newtable->invert == 1
+				// Count entries
+				iptr = token;
+				newtable->size1 = 1;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size1++;
+				}
+				newtable->idx1.times = (double *)malloc(newtable->size1 *
+					sizeof(double));
+				newtable->size1 = 0;
+				iptr = token;
+				sscanf(iptr, "%lg", &newtable->idx1.times[0]);
+				newtable->idx1.times[0] *= time_unit;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    newtable->size1++;
+				    sscanf(iptr, "%lg",
+						&newtable->idx1.times[newtable->size1]);
+				    newtable->idx1.times[newtable->size1] *= time_unit;
+				}
+				newtable->size1++;
+			    }
+
+			    token = advancetoken(flib, ';'); // EOL semicolon
+			}
+		    }
+		}
+		else if (!strcasecmp(token, "cell")) {
+		    newcell = (cell *)malloc(sizeof(cell));
+		    newcell->next = NULL;
+		    newcell->name = NULL;
+		    newcell->function = NULL;
+		    newcell->pins = NULL;
+		    if (lastcell != NULL)
+			lastcell->next = newcell;
+		    else
+			*celllist = newcell;
+		    lastcell = newcell;
+		    token = advancetoken(flib, 0);	// Open parens
+		    if (!strcmp(token, "("))
+			token = advancetoken(flib, ')');	// Cellname
+		    newcell->name = strdup(token);
+		    token = advancetoken(flib, 0);	// Find start of block
+		    if (strcmp(token, "{"))
+			fprintf(stderr, "Error: failed to find start of block\n");
+		    newcell->type = GATE;		// Default type
+		    newcell->area = 1.0;
+		    newcell->maxtrans = 0.0;
+		    newcell->maxcap = 0.0;
+		    section = CELLDEF;
+		}
+		else if (!strcasecmp(token, "time_unit")) {
+		   char *metric;
+
+		   token = advancetoken(flib, 0);
+		   if (token == NULL) break;
+		   if (!strcmp(token, ":")) {
+		      token = advancetoken(flib, 0);
+		      if (token == NULL) break;
+		   }
+		   if (!strcmp(token, "\"")) {
+		      token = advancetoken(flib, '\"');
+		      if (token == NULL) break;
+		   }
+		   time_unit = strtod(token, &metric);
+		   if (*metric != '\0') {
+		      if (!strcmp(metric, "ns"))
+			 time_unit *= 1E3;
+		      else if (!strcmp(metric, "us"))
+			 time_unit *= 1E6;
+		      else if (!strcmp(metric, "fs"))
+			 time_unit *= 1E-3;
+		      else if (strcmp(metric, "ps"))
+			 fprintf(stderr, "Don't understand time units \"%s\"\n",
+				token);
+		   }
+		   else {
+		      token = advancetoken(flib, 0);
+		      if (token == NULL) break;
+		      if (!strcmp(token, "ns"))
+			 time_unit *= 1E3;
+		      else if (!strcmp(token, "us"))
+			 time_unit *= 1E6;
+		      else if (!strcmp(token, "fs"))
+			 time_unit *= 1E-3;
+		      else if (strcmp(token, "ps"))
+			 fprintf(stderr, "Don't understand time units \"%s\"\n",
+				token);
+		   }
+		   token = advancetoken(flib, ';');
+		}
+		else if (!strcasecmp(token, "capacitive_load_unit")) {
+		   char *metric;
+
+		   token = advancetoken(flib, 0);
+		   if (token == NULL) break;
+		   if (!strcmp(token, "(")) {
+		      token = advancetoken(flib, ')');
+		      if (token == NULL) break;
+		   }
+		   cap_unit = strtod(token, &metric);
+		   if (*metric != '\0') {
+		      while (isspace(*metric)) metric++;
+		      if (*metric == ',') metric++;
+		      while ((*metric != '\0') && isspace(*metric)) metric++;
+		      if (!strcasecmp(metric, "af"))
+			 cap_unit *= 1E-3;
+		      else if (!strcasecmp(metric, "pf"))
+			 cap_unit *= 1000;
+		      else if (!strcasecmp(metric, "nf"))
+			 cap_unit *= 1E6;
+		      else if (!strcasecmp(metric, "uf"))
+			 cap_unit *= 1E9;
+		      else if (strcasecmp(metric, "ff"))
+			 fprintf(stderr, "Don't understand capacitive units \"%s\"\n",
+				token);
+		   }
+		   else {
+		      token = advancetoken(flib, 0);
+		      if (token == NULL) break;
+		      if (!strcasecmp(token, "af"))
+			 cap_unit *= 1E-3;
+		      else if (!strcasecmp(token, "pf"))
+			 cap_unit *= 1000;
+		      else if (!strcasecmp(token, "nf"))
+			 cap_unit *= 1E6;
+		      else if (!strcasecmp(token, "uf"))
+			 cap_unit *= 1E9;
+		      else if (strcasecmp(token, "ff"))
+			 fprintf(stderr, "Don't understand capacitive units \"%s\"\n",
+				token);
+		   }
+		   token = advancetoken(flib, ';');
+		}
+		else {
+		    // For unhandled tokens, read in tokens.  If it is
+		    // a definition or function, read to end-of-line.  If
+		    // it is a block definition, read to end-of-block.
+		    while (1) {
+			token = advancetoken(flib, 0);
+			if (token == NULL) break;
+			if (!strcmp(token, ";")) break;
+			if (!strcmp(token, "\""))
+			    token = advancetoken(flib, '\"');
+			if (!strcmp(token, "{")) {
+			    token = advancetoken(flib, '}');
+			    break;
+			}
+		    }
+		}
+		break;
+
+	    case CELLDEF:
+
+		if (!strcmp(token, "}")) {
+		    section = LIBBLOCK;			// End of cell def
+		}
+		else if (!strcasecmp(token, "pin")) {
+		    token = advancetoken(flib, 0);	// Open parens
+		    if (!strcmp(token, "("))
+			token = advancetoken(flib, ')');	// Close parens
+
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+
+		    token = advancetoken(flib, 0);	// Find start of block
+		    if (strcmp(token, "{"))
+			fprintf(stderr, "Error: failed to find start of block\n");
+		    section = PINDEF;
+		}		
+		else if (!strcasecmp(token, "area")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    sscanf(token, "%lg", &newcell->area);
+		}
+		else if (!strcasecmp(token, "ff")) {
+		    newcell->type |= DFF;
+		    token = advancetoken(flib, '{');
+		    section = FLOPDEF;
+		}
+		else if (!strcasecmp(token, "latch")) {
+		    newcell->type |= LATCH;
+		    token = advancetoken(flib, '{');
+		    section = LATCHDEF;
+		}
+		else {
+		    // For unhandled tokens, read in tokens.  If it is
+		    // a definition or function, read to end-of-line.  If
+		    // it is a block definition, read to end-of-block.
+		    while (1) {
+			token = advancetoken(flib, 0);
+			if (token == NULL) break;
+			if (!strcmp(token, ";")) break;
+			if (!strcmp(token, "\""))
+			    token = advancetoken(flib, '\"');
+			if (!strcmp(token, "("))
+			    token = advancetoken(flib, ')');
+			if (!strcmp(token, "{")) {
+			    token = advancetoken(flib, '}');
+			    break;
+			}
+		    }
+		}
+		break;
+
+	    case FLOPDEF:
+
+		if (!strcmp(token, "}")) {
+		    section = CELLDEF;			// End of flop def
+		}
+		else if (!strcasecmp(token, "next_state")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+		    newpin->type |= DFFIN;
+		}
+		else if (!strcasecmp(token, "clocked_on")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    if (strchr(token, '\'') != NULL)
+			newcell->type |= CLK_SENSE_MASK;
+		    else if (strchr(token, '!') != NULL)
+			newcell->type |= CLK_SENSE_MASK;
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+		    newpin->type |= DFFCLK;
+		}
+		else if (!strcasecmp(token, "clear")) {
+		    newcell->type |= RST_MASK;
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    if (strchr(token, '\'') != NULL)
+			newcell->type |= RST_SENSE_MASK;
+		    else if (strchr(token, '!') != NULL)
+			newcell->type |= RST_SENSE_MASK;
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+		    newpin->type |= DFFRST;
+		}
+		else if (!strcasecmp(token, "preset")) {
+		    newcell->type |= SET_MASK;
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    if (strchr(token, '\'') != NULL)
+			newcell->type |= SET_SENSE_MASK;
+		    else if (strchr(token, '!') != NULL)
+			newcell->type |= SET_SENSE_MASK;
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+		    newpin->type |= DFFSET;
+		}
+		else
+		    token = advancetoken(flib, ';');	// Read to end-of-statement
+
+		break;
+
+	    case LATCHDEF:
+
+		if (!strcmp(token, "}")) {
+		    section = CELLDEF;			// End of flop def
+		}
+		else if (!strcasecmp(token, "data_in")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+		    newpin->type |= LATCHIN;
+		}
+		else if (!strcasecmp(token, "enable")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    if (strchr(token, '\'') != NULL)
+			newcell->type |= EN_SENSE_MASK;
+		    else if (strchr(token, '!') != NULL)
+			newcell->type |= EN_SENSE_MASK;
+		    newpin = parse_pin(newcell, token, SENSE_NONE);
+		    newpin->type |= LATCHEN;
+		}
+		else
+		    token = advancetoken(flib, ';');	// Read to end-of-statement
+
+		break;
+
+	    case PINDEF:
+
+		if (!strcmp(token, "}")) {
+		    section = CELLDEF;			// End of pin def
+		}
+		else if (!strcasecmp(token, "capacitance")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    sscanf(token, "%lg", &newpin->capr);
+		    newpin->capr *= cap_unit;
+		}
+		else if (!strcasecmp(token, "rise_capacitance")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    sscanf(token, "%lg", &newpin->capr);
+		    newpin->capr *= cap_unit;
+		}
+		else if (!strcasecmp(token, "fall_capacitance")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    sscanf(token, "%lg", &newpin->capf);
+		    newpin->capf *= cap_unit;
+		}
+		else if (!strcasecmp(token, "function")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, 0);	// Open quote
+		    if (!strcmp(token, "\""))
+			token = advancetoken(flib, '\"');	// Find function string
+		    if (newpin->type & OUTPUT) {
+			newcell->function = strdup(token);
+		    }
+		    token = advancetoken(flib, 0);
+		    if (strcmp(token, ";"))
+			fprintf(stderr, "Expected end-of-statement.\n");
+		}
+		else if (!strcasecmp(token, "direction")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');
+		    if (!strcasecmp(token, "input")) {
+			newpin->type |= INPUT;
+		    }
+		    else if (!strcasecmp(token, "output")) {
+			newpin->type |= OUTPUT;
+		    }
+		}
+		else if (!strcasecmp(token, "max_transition")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    sscanf(token, "%lg", &newcell->maxtrans);
+		    newcell->maxtrans *= time_unit;
+		}
+		else if (!strcasecmp(token, "max_capacitance")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// To end-of-statement
+		    sscanf(token, "%lg", &newcell->maxcap);
+		    newcell->maxcap *= cap_unit;
+		}
+		else if (!strcasecmp(token, "timing")) {
+		    token = advancetoken(flib, 0);	// Arguments, if any
+		    if (strcmp(token, "("))
+			fprintf(stderr, "Error: failed to find start of block\n");
+		    else
+		       token = advancetoken(flib, ')');	// Arguments, if any
+		    token = advancetoken(flib, 0);	// Find start of block
+		    if (strcmp(token, "{"))
+			fprintf(stderr, "Error: failed to find start of block\n");
+		    testpin = NULL;
+		    sense_type = SENSE_NONE;
+		    section = TIMING;
+		}
+		else {
+		    // For unhandled tokens, read in tokens.  If it is
+		    // a definition or function, read to end-of-line.  If
+		    // it is a block definition, read to end-of-block.
+		    while (1) {
+			token = advancetoken(flib, 0);
+			if (token == NULL) break;
+			if (!strcmp(token, ";")) break;
+			if (!strcmp(token, "\""))
+			    token = advancetoken(flib, '\"');
+			if (!strcmp(token, "{")) {
+			    token = advancetoken(flib, '}');
+			    break;
+			}
+		    }
+		}
+		break;
+
+	    case TIMING:
+
+		if (!strcmp(token, "}")) {
+		    section = PINDEF;			// End of timing def
+		}
+		else if (!strcasecmp(token, "related_pin")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// Read to end of statement
+		    // Create the related pin if needed
+		    testpin = parse_pin(newcell, token, sense_type);
+		}
+		else if (!strcasecmp(token, "timing_sense")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// Read to end of statement
+		    if (!strcasecmp(token, "positive_unate")) {
+			if (testpin)
+			   testpin->sense = SENSE_POSITIVE;
+			else
+			   sense_type = SENSE_POSITIVE;
+		    }
+		    else if (!strcasecmp(token, "negative_unate")) {
+			if (testpin)
+			   testpin->sense = SENSE_NEGATIVE;
+			else
+			   sense_type = SENSE_NEGATIVE;
+		    }
+		    else if (!strcasecmp(token, "non_unate")) {
+			if (testpin)
+			   testpin->sense = SENSE_NONE;
+			else
+			   sense_type = SENSE_NONE;
+		    }
+		}
+		else if (!strcasecmp(token, "timing_type")) {
+		    token = advancetoken(flib, 0);	// Colon
+		    token = advancetoken(flib, ';');	// Read to end of statement
+
+		    // Note:  Timing type is apparently redundant information;
+		    // e.g., "falling_edge" can be determined by "clocked_on : !CLK"
+		    // in the ff {} block.  How reliable is this?
+
+		    if (!strcasecmp(token, "rising_edge"))
+			timing_type = TIMING_PROP_TRANS;
+		    else if (!strcasecmp(token, "falling_edge"))
+			timing_type = TIMING_PROP_TRANS;
+		    else if (!strcasecmp(token, "hold_rising"))
+			timing_type = TIMING_HOLD;
+		    else if (!strcasecmp(token, "hold_falling"))
+			timing_type = TIMING_HOLD;
+		    else if (!strcasecmp(token, "setup_rising"))
+			timing_type = TIMING_SETUP;
+		    else if (!strcasecmp(token, "setup_falling"))
+			timing_type = TIMING_SETUP;
+		    else if (!strcasecmp(token, "clear"))
+			timing_type = TIMING_SET_RESET;
+		    else if (!strcasecmp(token, "preset"))
+			timing_type = TIMING_SET_RESET;
+		    else if (!strcasecmp(token, "recovery_rising"))
+			timing_type = TIMING_RECOVERY;
+		    else if (!strcasecmp(token, "recovery_falling"))
+			timing_type = TIMING_RECOVERY;
+		    else if (!strcasecmp(token, "removal_rising"))
+			timing_type = TIMING_REMOVAL;
+		    else if (!strcasecmp(token, "removal_falling"))
+			timing_type = TIMING_REMOVAL;
+		    else if (!strcasecmp(token, "three_state_enable"))
+			timing_type = TIMING_TRISTATE;
+		    else if (!strcasecmp(token, "three_state_disable"))
+			timing_type = TIMING_TRISTATE;
+		}
+		else if ((!strcasecmp(token, "cell_rise")) ||
+			(!strcasecmp(token, "cell_fall")) ||
+			(!strcasecmp(token, "rise_transition")) ||
+			(!strcasecmp(token, "fall_transition")) ||
+			(!strcasecmp(token, "rise_constraint")) ||
+			(!strcasecmp(token, "fall_constraint"))) {
+
+		    tableptr = (lutable *)malloc(sizeof(lutable));
+		    tableptr->name = NULL;	// Not used
+		    tableptr->invert = 0;
+		    tableptr->var1 = UNKNOWN;
+		    tableptr->var2 = UNKNOWN;
+		    tableptr->size1 = 0;
+		    tableptr->size2 = 0;
+		    tableptr->idx1.times = NULL;
+		    tableptr->idx2.caps = NULL;
+		    tableptr->values = NULL;
+		    tableptr->next = NULL;	// Not used
+
+		    // Note that propagation delays (cell rise, cell fall) and
+		    // transition times (rise transition, fall transition) have
+		    // their lookup tables stored in the "related pin" pin record.
+		    // Setup and hold times (rise constraint, fall constraint)
+		    // have their lookup tables stored in the original pin record.
+		    // These should not overlap.
+
+		    // Recovery and removal tables are not yet handled. . .
+
+		    if (!strcasecmp(token, "cell_rise"))
+			testpin->propdelr = tableptr;
+		    else if (!strcasecmp(token, "cell_fall"))
+			testpin->propdelf = tableptr;
+		    else if (!strcasecmp(token, "rise_transition"))
+			testpin->transr = tableptr;
+		    else if (!strcasecmp(token, "fall_transition"))
+			testpin->transf = tableptr;
+		    else if (!strcasecmp(token, "rise_constraint")) {
+			if (timing_type == TIMING_SETUP)
+			    newpin->propdelr = tableptr;
+			else if (timing_type == TIMING_HOLD)
+			    newpin->transr = tableptr;
+		    }
+		    else if (!strcasecmp(token, "fall_constraint")) {
+			if (timing_type == TIMING_SETUP)
+			    newpin->propdelf = tableptr;
+			else if (timing_type == TIMING_HOLD)
+			    newpin->transf = tableptr;
+		    }
+
+		    token = advancetoken(flib, 0);	// Open parens
+		    if (!strcmp(token, "("))
+			token = advancetoken(flib, ')');
+		    if (strcmp(token, "scalar")) {
+			
+		        reftable = (lutable *)hash_lookup(&templates, token, NULL);
+		        if (reftable == NULL)
+			    fprintf(stderr, "Failed to find a valid table \"%s\"\n",
+				    token);
+		        else {
+			    // Fill in default values from template reftable
+			    tableptr->invert = reftable->invert;
+			    if (reftable->size1 > 0) {
+				tableptr->var1 = reftable->var1;
+				tableptr->size1 = reftable->size1;
+				tableptr->idx1.times = (double *)malloc(tableptr->size1 * sizeof(double));
+				memcpy(tableptr->idx1.times, reftable->idx1.times,
+						tableptr->size1 * sizeof(double));
+			    }
+			    if (reftable->size2 > 0) {
+				tableptr->var2 = reftable->var2;
+				tableptr->size2 = reftable->size2;
+				tableptr->idx2.caps = (double *)malloc(tableptr->size2 * sizeof(double));
+				memcpy(tableptr->idx2.caps, reftable->idx2.caps,
+						tableptr->size2 * sizeof(double));
+			    }
+			}
+		    }
+
+		    token = advancetoken(flib, 0);
+		    if (strcmp(token, "{"))
+			fprintf(stderr, "Failed to find start of timing block\n");
+
+		    while (*token != '}') {
+		        token = advancetoken(flib, 0);
+		        if (!strcasecmp(token, "index_1")) {
+
+			    // Local index values override those in the template
+
+			    token = advancetoken(flib, 0);	// Open parens
+			    token = advancetoken(flib, 0);	// Quote
+			    if (!strcmp(token, "\""))
+				token = advancetoken(flib, '\"');
+
+			    //-------------------------
+
+			    if (reftable && (reftable->invert == 1)) {
+				// Entries had better match the ref table
+				iptr = token;
+				i = 0;
+				sscanf(iptr, "%lg", &tableptr->idx2.caps[0]);
+				if (tableptr->var2 == OUTPUT_CAP)
+				    tableptr->idx2.caps[0] *= cap_unit;
+				else
+				    tableptr->idx2.cons[0] *= time_unit;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    i++;
+				    sscanf(iptr, "%lg", &tableptr->idx2.caps[i]);
+				    if (tableptr->var2 == OUTPUT_CAP)
+					tableptr->idx2.caps[i] *= cap_unit;
+				    else
+					tableptr->idx2.cons[i] *= time_unit;
+				}
+			    }
+			    else if (reftable && (reftable->invert == 0)) {
+				iptr = token;
+				i = 0;
+				sscanf(iptr, "%lg", &tableptr->idx1.times[0]);
+				tableptr->idx1.times[0] *= time_unit;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    i++;
+				    sscanf(iptr, "%lg", &tableptr->idx1.times[i]);
+				    tableptr->idx1.times[i] *= time_unit;
+				}
+			    }
+
+			    token = advancetoken(flib, ')'); 	// Close paren
+			    token = advancetoken(flib, ';');	// EOL semicolon
+			}
+		        else if (!strcasecmp(token, "index_2")) {
+
+			    // Local index values override those in the template
+
+			    token = advancetoken(flib, 0);	// Open parens
+			    token = advancetoken(flib, 0);	// Quote
+			    if (!strcmp(token, "\""))
+				token = advancetoken(flib, '\"');
+
+			    //-------------------------
+
+			    if (reftable && (reftable->invert == 1)) {
+				// Entries had better match the ref table
+				iptr = token;
+				i = 0;
+				sscanf(iptr, "%lg", &tableptr->idx1.times[0]);
+				tableptr->idx1.times[0] *= time_unit;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    i++;
+				    sscanf(iptr, "%lg", &tableptr->idx1.times[i]);
+				    tableptr->idx1.times[i] *= time_unit;
+				}
+			    }
+			    else if (reftable && (reftable->invert == 0)) {
+				iptr = token;
+				i = 0;
+				sscanf(iptr, "%lg", &tableptr->idx2.caps[0]);
+				tableptr->idx2.caps[0] *= cap_unit;
+				while ((iptr = strchr(iptr, ',')) != NULL) {
+				    iptr++;
+				    i++;
+				    sscanf(iptr, "%lg", &tableptr->idx2.caps[i]);
+				    tableptr->idx2.caps[i] *= cap_unit;
+				}
+			    }
+
+			    token = advancetoken(flib, ')'); 	// Close paren
+			    token = advancetoken(flib, ';');	// EOL semicolon
+			}
+			else if (!strcasecmp(token, "values")) {
+			    token = advancetoken(flib, 0);	
+			    if (strcmp(token, "("))
+				fprintf(stderr, "Failed to find start of"
+						" value table\n");
+			    token = advancetoken(flib, ')');
+
+			    // Parse the string of values and enter it into the
+			    // table "values", which is size size1 x size2, with
+			    // the idx2 entries of each idx1 entry together
+
+			    if (reftable && reftable->size1 > 0) {
+				int locsize2;
+			        locsize2 = (reftable->size2 > 0) ? reftable->size2 : 1;
+				if (reftable->invert) {
+				    tableptr->values = (double *)malloc(locsize2 *
+						reftable->size1 * sizeof(double));
+				    iptr = token;
+				    for (j = 0; j < locsize2; j++) {
+					for (i = 0; i < reftable->size1; i++) {
+					    while (*iptr == ' ' || *iptr == '\"' ||
+							*iptr == ',')
+						iptr++;
+					    sscanf(iptr, "%lg", &gval);
+					    *(tableptr->values + i * locsize2
+							+ j) = gval * time_unit;
+					    while (*iptr != ' ' && *iptr != '\"' &&
+							*iptr != ',')
+						iptr++;
+					}
+				    }
+				}
+				else {
+				    tableptr->values = (double *)malloc(locsize2 *
+						reftable->size1 * sizeof(double));
+				    iptr = token;
+				    for (j = 0; j < locsize2; j++) {
+					for (i = 0; i < reftable->size1; i++) {
+					    while (*iptr == ' ' || *iptr == '\"' ||
+							*iptr == ',')
+						iptr++;
+					    sscanf(iptr, "%lg", &gval);
+					    *(tableptr->values + j * reftable->size1
+							+ i) = gval * time_unit;
+					    while (*iptr != ' ' && *iptr != '\"' &&
+							*iptr != ',')
+						iptr++;
+					}
+				    }
+				}
+			    }
+
+			    token = advancetoken(flib, 0);
+			    if (strcmp(token, ";"))
+				fprintf(stderr, "Failed to find end of value table\n");
+			    token = advancetoken(flib, 0);
+
+			}
+			else if (strcmp(token, "{"))
+			    fprintf(stderr, "Failed to find end of timing block\n");
+		    }
+		}
+		else {
+		    // For unhandled tokens, read in tokens.  If it is
+		    // a definition or function, read to end-of-line.  If
+		    // it is a block definition, read to end-of-block.
+		    while (1) {
+			token = advancetoken(flib, 0);
+			if (token == NULL) break;
+			if (!strcmp(token, ";")) break;
+			if (!strcmp(token, "\""))
+			    token = advancetoken(flib, '\"');
+			if (!strcmp(token, "{")) {
+			    token = advancetoken(flib, '}');
+			    break;
+			}
+		    }
+		}
+		break;
+	}
+	token = advancetoken(flib, 0);
+    }
+    flib->onerror = NULL;
+    hash_free(&templates);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Make the timing tables of all cell pins share their index	*/
+/* arrays wherever the index values are the same, as they are	*/
+/* for the rise and fall tables made from one template.  Then	*/
+/* vector_get_pair() can find the bounding index entries once	*/
+/* for both tables.  The duplicate arrays are not freed, as	*/
+/* they may be part of a mapped liberty cache.			*/
+/*--------------------------------------------------------------*/
+
+static double *
+share_index(double ***shared, int **sizes, int *numshared, double *index, int size)
+{
+    int i;
+
+    if (index == NULL) return NULL;
+    for (i = 0; i < *numshared; i++)
+	if (((*sizes)[i] == size) && !memcmp((*shared)[i], index, size * sizeof(double)))
+	    return (*shared)[i];
+
+    if ((*numshared & 63) == 0) {
+	*shared = (double **)realloc(*shared, (*numshared + 64) * sizeof(double *));
+	*sizes = (int *)realloc(*sizes, (*numshared + 64) * sizeof(int));
+    }
+    (*shared)[*numshared] = index;
+    (*sizes)[*numshared] = size;
+    (*numshared)++;
+    return index;
+}
+
+static void
+share_table_indexes(cell *cells)
+{
+    cell    *testcell;
+    pin	    *testpin;
+    lutable *tables[4];
+    double  **shared = NULL;
+    int	    *sizes = NULL;
+    int	    numshared = 0, i;
+
+    for (testcell = cells; testcell; testcell = testcell->next) {
+	for (testpin = testcell->pins; testpin; testpin = testpin->next) {
+	    tables[0] = testpin->propdelr;
+	    tables[1] = testpin->propdelf;
+	    tables[2] = testpin->transr;
+	    tables[3] = testpin->transf;
+	    for (i = 0; i < 4; i++) {
+		if (tables[i] == NULL) continue;
+		tables[i]->idx1.times = share_index(&shared, &sizes, &numshared,
+			tables[i]->idx1.times, tables[i]->size1);
+		tables[i]->idx2.caps = share_index(&shared, &sizes, &numshared,
+			tables[i]->idx2.caps, tables[i]->size2);
+	    }
+	}
+    }
+    free(shared);
+    free(sizes);
+}
+
+/*--------------------------------------------------------------*/
+/* Binary liberty cache.  The parsed table templates, cells,	*/
+/* pins, and timing tables are written to a single image in	*/
+/* which every pointer is stored as an offset from the start of	*/
+/* the image (0 for NULL).  The image ends with a list of the	*/
+/* positions of all of the pointers, so that loading the cache	*/
+/* is a matter of mapping the file and adding the base address	*/
+/* to each of them.  The image is only valid for the liberty	*/
+/* file content that it was made from, and for the same build	*/
+/* (pointer size and structure layout).				*/
+/*--------------------------------------------------------------*/
+
+// Append an object of "size" bytes (zero-filled) to the image, and
+// return its offset.
+
+static size_t
+cache_reserve(cachebuf *cbuf, size_t size)
+{
+    size_t offset;
+
+    size = (size + sizeof(double) - 1) & ~(sizeof(double) - 1);
+    if (cbuf->size + size > cbuf->alloc) {
+	while (cbuf->size + size > cbuf->alloc) cbuf->alloc <<= 1;
+	cbuf->data = (char *)realloc(cbuf->data, cbuf->alloc);
+    }
+    offset = cbuf->size;
+    memset(cbuf->data + offset, 0, size);
+    cbuf->size += size;
+    return offset;
+}
+
+// Set the pointer at image offset "field" to point to image offset
+// "target", and record its position for relocation.
+
+static void
+cache_pointer(cachebuf *cbuf, size_t field, size_t target)
+{
+    *((size_t *)(cbuf->data + field)) = target;
+    if (target == 0) return;
+    if (cbuf->numrelocs == cbuf->allocrelocs) {
+	cbuf->allocrelocs <<= 1;
+	cbuf->relocs = (size_t *)realloc(cbuf->relocs, cbuf->allocrelocs *
+			sizeof(size_t));
+    }
+    cbuf->relocs[cbuf->numrelocs++] = field;
+}
+
+static size_t
+cache_data(cachebuf *cbuf, void *data, size_t size)
+{
+    size_t offset;
+
+    if (data == NULL) return 0;
+    offset = cache_reserve(cbuf, size);
+    memcpy(cbuf->data + offset, data, size);
+    return offset;
+}
+
+static size_t
+cache_string(cachebuf *cbuf, char *string)
+{
+    if (string == NULL) return 0;
+    return cache_data(cbuf, string, strlen(string) + 1);
+}
+
+// Copy a lookup table into the image (not including the "next" link)
+
+static size_t
+cache_table(cachebuf *cbuf, lutable *table)
+{
+    size_t offset, n;
+    lutable *ctable;
+
+    if (table == NULL) return 0;
+    offset = cache_reserve(cbuf, sizeof(lutable));
+    ctable = (lutable *)(cbuf->data + offset);
+    ctable->invert = table->invert;
+    ctable->var1 = table->var1;
+    ctable->var2 = table->var2;
+    ctable->size1 = table->size1;
+    ctable->size2 = table->size2;
+
+    // Note:  "ctable" is not valid after any further allocation
+
+    n = cache_string(cbuf, table->name);
+    cache_pointer(cbuf, offset + offsetof(lutable, name), n);
+    n = cache_data(cbuf, table->idx1.times, table->size1 * sizeof(double));
+    cache_pointer(cbuf, offset + offsetof(lutable, idx1), n);
+    n = cache_data(cbuf, table->idx2.caps, table->size2 * sizeof(double));
+    cache_pointer(cbuf, offset + offsetof(lutable, idx2), n);
+    if (table->values != NULL) {
+	n = cache_data(cbuf, table->values, table->size1 *
+			((table->size2 > 0) ? table->size2 : 1) * sizeof(double));
+	cache_pointer(cbuf, offset + offsetof(lutable, values), n);
+    }
+    return offset;
+}
+
+// Copy a pin into the image (not including the "next" link)
+
+static size_t
+cache_pin(cachebuf *cbuf, pin *testpin, size_t celloffset)
+{
+    size_t offset, n;
+    pin *cpin;
+
+    offset = cache_reserve(cbuf, sizeof(pin));
+    cpin = (pin *)(cbuf->data + offset);
+    cpin->type = testpin->type;
+    cpin->capr = testpin->capr;
+    cpin->capf = testpin->capf;
+    cpin->sense = testpin->sense;
+
+    n = cache_string(cbuf, testpin->name);
+    cache_pointer(cbuf, offset + offsetof(pin, name), n);
+    n = cache_table(cbuf, testpin->propdelr);
+    cache_pointer(cbuf, offset + offsetof(pin, propdelr), n);
+    n = cache_table(cbuf, testpin->propdelf);
+    cache_pointer(cbuf, offset + offsetof(pin, propdelf), n);
+    n = cache_table(cbuf, testpin->transr);
+    cache_pointer(cbuf, offset + offsetof(pin, transr), n);
+    n = cache_table(cbuf, testpin->transf);
+    cache_pointer(cbuf, offset + offsetof(pin, transf), n);
+    cache_pointer(cbuf, offset + offsetof(pin, refcell), celloffset);
+    return offset;
+}
+
+// Copy a cell and its pins into the image (not including the "next" link)
+
+static size_t
+cache_cell(cachebuf *cbuf, cell *testcell)
+{
+    size_t offset, n, lastpin, newpin;
+    pin *testpin;
+    cell *ccell;
+
+    offset = cache_reserve(cbuf, sizeof(cell));
+    ccell = (cell *)(cbuf->data + offset);
+    ccell->type = testcell->type;
+    ccell->area = testcell->area;
+    ccell->maxtrans = testcell->maxtrans;
+    ccell->maxcap = testcell->maxcap;
+
+    n = cache_string(cbuf, testcell->name);
+    cache_pointer(cbuf, offset + offsetof(cell, name), n);
+    n = cache_string(cbuf, testcell->function);
+    cache_pointer(cbuf, offset + offsetof(cell, function), n);
+
+    lastpin = 0;
+    for (testpin = testcell->pins; testpin; testpin = testpin->next) {
+	newpin = cache_pin(cbuf, testpin, offset);
+	if (lastpin == 0)
+	    cache_pointer(cbuf, offset + offsetof(cell, pins), newpin);
+	else
+	    cache_pointer(cbuf, lastpin + offsetof(pin, next), newpin);
+	lastpin = newpin;
+    }
+    return offset;
+}
+
+/*--------------------------------------------------------------*/
+/* Add "n" bytes at "data" to the hash "hashval" (FNV-1a,	*/
+/* starting from LIBCACHE_HASH_INIT).				*/
+/*--------------------------------------------------------------*/
+
+#define LIBCACHE_HASH_INIT	14695981039346656037UL
+
+static unsigned long
+libcache_hash(unsigned long hashval, unsigned char *data, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+	hashval ^= data[i];
+	hashval *= 1099511628211UL;
+    }
+    return hashval;
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the hash used to match a cache to its liberty file.	*/
+/* Returns 0 if the file cannot be read.			*/
+/*--------------------------------------------------------------*/
+
+static unsigned long
+libcache_source_hash(char *libname)
+{
+    FILE *flib;
+    unsigned char buffer[65536];
+    unsigned long hashval = LIBCACHE_HASH_INIT;
+    size_t n;
+
+    flib = fopen(libname, "r");
+    if (flib == NULL) return 0;
+    while ((n = fread(buffer, 1, sizeof(buffer), flib)) > 0)
+	hashval = libcache_hash(hashval, buffer, n);
+    fclose(flib);
+    return hashval;
+}
+
+/*--------------------------------------------------------------*/
+/* Write the liberty database to the cache file "cachename".	*/
+/* Return 0 on success, 1 on failure.				*/
+/*--------------------------------------------------------------*/
+
+static int
+libcache_write(char *cachename, unsigned long srchash, lutable *tables, cell *cells)
+{
+    cachebuf cbuf;
+    libcache *header;
+    lutable *testtable;
+    cell *testcell;
+    size_t last, next, relocs;
+    FILE *fcache;
+    char *tmpname;
+    int fd, result;
+
+    cbuf.alloc = 65536;
+    cbuf.size = 0;
+    cbuf.data = (char *)malloc(cbuf.alloc);
+    cbuf.allocrelocs = 1024;
+    cbuf.numrelocs = 0;
+    cbuf.relocs = (size_t *)malloc(cbuf.allocrelocs * sizeof(size_t));
+
+    cache_reserve(&cbuf, sizeof(libcache));
+
+    last = 0;
+    for (testtable = tables; testtable; testtable = testtable->next) {
+	next = cache_table(&cbuf, testtable);
+	if (last == 0)
+	    cache_pointer(&cbuf, offsetof(libcache, tables), next);
+	else
+	    cache_pointer(&cbuf, last + offsetof(lutable, next), next);
+	last = next;
+    }
+
+    last = 0;
+    for (testcell = cells; testcell; testcell = testcell->next) {
+	next = cache_cell(&cbuf, testcell);
+	if (last == 0)
+	    cache_pointer(&cbuf, offsetof(libcache, cells), next);
+	else
+	    cache_pointer(&cbuf, last + offsetof(cell, next), next);
+	last = next;
+    }
+
+    relocs = cache_data(&cbuf, cbuf.relocs, cbuf.numrelocs * sizeof(size_t));
+
+    header = (libcache *)cbuf.data;
+    memcpy(header->magic, LIBCACHE_MAGIC, sizeof(header->magic));
+    header->version = LIBCACHE_VERSION;
+    header->ptrsize = sizeof(void *);
+    header->srchash = srchash;
+    header->size = cbuf.size;
+    header->relocs = relocs;
+    header->numrelocs = cbuf.numrelocs;
+    header->imagehash = libcache_hash(LIBCACHE_HASH_INIT,
+		(unsigned char *)cbuf.data + sizeof(libcache),
+		cbuf.size - sizeof(libcache));
+
+    // Another process may have the cache mapped (see libcache_read()),
+    // so the file is not rewritten in place.  The new image is written
+    // to a file of its own, which is then renamed over the cache.
+
+    result = 1;
+    tmpname = (char *)malloc(strlen(cachename) + 16);
+    sprintf(tmpname, "%s.%d", cachename, (int)getpid());
+    fd = open(tmpname, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    fcache = (fd < 0) ? NULL : fdopen(fd, "w");
+    if (fcache != NULL) {
+	if (fwrite(cbuf.data, 1, cbuf.size, fcache) == cbuf.size) result = 0;
+	if (fclose(fcache) != 0) result = 1;
+	if ((result == 0) && (rename(tmpname, cachename) != 0)) result = 1;
+    }
+    else if (fd >= 0)
+	close(fd);
+    if (result != 0) {
+	fprintf(stderr, "Cannot write liberty cache %s\n", cachename);
+	unlink(tmpname);
+    }
+
+    free(tmpname);
+    free(cbuf.data);
+    free(cbuf.relocs);
+    return result;
+}
+
+// Return 1 if "ptr" is NULL or points inside the "size" bytes of
+// the cache file mapped at "base".
+
+static int
+cache_pointer_valid(void *ptr, char *base, size_t size)
+{
+    return ((ptr == NULL) || (((char *)ptr >= base) &&
+		((char *)ptr < base + size)));
+}
+
+/*--------------------------------------------------------------*/
+/* Load the liberty database from the cache file "cachename",	*/
+/* if it exists and was made from a liberty file with hash	*/
+/* "srchash".  Return 0 on success, 1 if the cache cannot be	*/
+/* used.  The image following the header must match the hash	*/
+/* recorded in the header, so a cache damaged after it was	*/
+/* written is rejected (and the liberty file parsed instead).	*/
+/* The hash detects damage, not a file crafted to match it;	*/
+/* the pointers are also checked to lie inside the file.  The	*/
+/* cache file is mapped into memory and is not unmapped.	*/
+/*--------------------------------------------------------------*/
+
+static int
+libcache_read(char *cachename, unsigned long srchash, lutable **tablelist,
+		cell **celllist)
+{
+    struct stat sbuf;
+    libcache *header;
+    size_t *relocs, *field;
+    char *base;
+    long i;
+    int fd;
+
+    fd = open(cachename, O_RDONLY);
+    if (fd < 0) return 1;
+    if ((fstat(fd, &sbuf) < 0) || (sbuf.st_size < sizeof(libcache))) {
+	close(fd);
+	return 1;
+    }
+    base = (char *)mmap(NULL, sbuf.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+		fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 1;
+
+    header = (libcache *)base;
+    if (memcmp(header->magic, LIBCACHE_MAGIC, sizeof(header->magic)) ||
+		(header->version != LIBCACHE_VERSION) ||
+		(header->ptrsize != sizeof(void *)) ||
+		(header->srchash != srchash) ||
+		(header->size != sbuf.st_size) ||
+		(header->relocs > header->size) ||
+		(header->relocs % sizeof(size_t) != 0) ||
+		(header->numrelocs < 0) ||
+		(header->numrelocs > (header->size - header->relocs) /
+		sizeof(size_t)) ||
+		(header->imagehash != libcache_hash(LIBCACHE_HASH_INIT,
+		(unsigned char *)base + sizeof(libcache),
+		header->size - sizeof(libcache)))) {
+	munmap(base, sbuf.st_size);
+	return 1;
+    }
+
+    // Pointer fields are aligned, lie inside the file, and hold a
+    // nonzero offset inside the file (a field listed twice would
+    // hold an address by the second time, and fail the test).
+
+    relocs = (size_t *)(base + header->relocs);
+    for (i = 0; i < header->numrelocs; i++) {
+	if ((relocs[i] > header->size - sizeof(void *)) ||
+		(relocs[i] % sizeof(void *) != 0))
+	    break;
+	field = (size_t *)(base + relocs[i]);
+	if ((*field == 0) || (*field >= header->size)) break;
+	*field += (size_t)base;
+    }
+    if ((i < header->numrelocs) ||
+		!cache_pointer_valid(header->tables, base, header->size) ||
+		!cache_pointer_valid(header->cells, base, header->size)) {
+	munmap(base, sbuf.st_size);
+	return 1;
+    }
+
+    *tablelist = header->tables;
+    *celllist = header->cells;
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Free the connection records of list "connlist".		*/
+/*--------------------------------------------------------------*/
+
+static void
+free_connections(connptr connlist)
+{
+    connptr nextconn;
+
+    for (; connlist; connlist = nextconn) {
+	nextconn = connlist->next;
+	free(connlist);
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Free the nets "netlist", the instances "instlist" and the	*/
+/* module pins "inputlist" and "outputlist" of a netlist read	*/
+/* by verilogRead(), before the nets are given their receivers	*/
+/* (see createLinks()).						*/
+/*--------------------------------------------------------------*/
+
+static void
+free_netlist(netptr netlist, instptr instlist, connptr inputlist,
+		connptr outputlist)
+{
+    netptr nextnet;
+    instptr nextinst;
+
+    for (; netlist; netlist = nextnet) {
+	nextnet = netlist->next;
+	free(netlist->name);
+	free(netlist);
+    }
+    for (; instlist; instlist = nextinst) {
+	nextinst = instlist->next;
+	free_connections(instlist->in_connects);
+	free_connections(instlist->out_connects);
+	free(instlist->name);
+	free(instlist);
+    }
+    free_connections(inputlist);
+    free_connections(outputlist);
+}
+
+/*--------------------------------------------------------------*/
+/* Read a verilog netlist and collect information about the	*/
+/* cells instantiated and the network structure.  Progress is	*/
+/* reported to "log" (if not NULL).  Return 0 on success, or -1	*/
+/* if the netlist is compressed and ends early, in which case	*/
+/* the part of the netlist read is freed.			*/
+/*--------------------------------------------------------------*/
+
+static int
+verilogRead(tokenstream *fsrc, cell *cells, net **netlist, instance **instlist,
+		connect **inputlist, connect **outputlist, FILE *log)
+{
+    char *token;
+    char *modname = NULL;
+    int section = MODULE;
+
+    instptr newinst;
+    netptr newnet, testnet;
+    cellptr testcell;
+    connptr newconn, testconn;
+    pinptr testpin;
+
+    hashtable celltable, pintable, nettable;
+    jmp_buf onerror;
+
+    int vstart, vend, vtarget, isinput;
+
+    // Index the cells and their pins by name.  Where a library defines
+    // the same cell name twice, the first definition is used.
+
+    hash_init(&celltable, 256, 1);
+    hash_init(&pintable, 1024, 0);
+    hash_init(&nettable, 4096, 0);
+
+    // Compressed input that ends early ends the parse here
+
+    fsrc->onerror = &onerror;
+    if (setjmp(onerror) != 0) {
+	fsrc->onerror = NULL;
+	hash_free(&celltable);
+	hash_free(&pintable);
+	hash_free(&nettable);
+	free_netlist(*netlist, *instlist, *inputlist, *outputlist);
+	*netlist = NULL;
+	*instlist = NULL;
+	*inputlist = *outputlist = NULL;
+	return -1;
+    }
+
+    for (testcell = cells; testcell; testcell = testcell->next) {
+	if (hash_lookup(&celltable, testcell->name, NULL) == NULL)
+	    hash_insert(&celltable, testcell->name, NULL, testcell);
+	for (testpin = testcell->pins; testpin; testpin = testpin->next)
+	    hash_insert(&pintable, testpin->name, testcell, testpin);
+    }
+
+    /* Read tokens off of the line */
+    token = advancetoken(fsrc, 0);
+
+    while (token != NULL) {
+
+	switch (section) {
+	    case MODULE:
+		if (!strcasecmp(token, "module")) {
+		    token = advancetoken(fsrc, 0);
+		    if (log != NULL)
+			fprintf(log, "Parsing module \"%s\"\n", token);
+
+		    token = advancetoken(fsrc, 0);
+		    if (strcmp(token, "("))
+			fprintf(stderr, "Module not followed by pin list\n");
+		    else
+			token = advancetoken(fsrc, ')');
+		    token = advancetoken(fsrc, ';');	// Get end-of-line
+
+		    // Ignore the pin list, go straight to the input/output declarations
+		    section = IOLIST;
+		}
+		break;
+
+	    case IOLIST:
+		if (!strcasecmp(token, "input") || !strcasecmp(token, "output")) {
+
+		    testconn = NULL;
+		    vstart = vend = 0;
+
+		    if (!strcasecmp(token, "input")) {
+			isinput = 1;
+		    }
+		    else { 	// output
+			isinput = 0;
+		    }
+
+		    token = advancetoken(fsrc, 0);
+		    if (*token == '[') {
+			sscanf(token + 1, "%d", &vstart);
+			token = advancetoken(fsrc, ':');
+			token = advancetoken(fsrc, ']');	// Read to end of vector
+			sscanf(token, "%d", &vend);
+			token = advancetoken(fsrc, 0);		// Read signal name
+		    }
+
+		    // Create a net entry for the input or output, add to the list of nets
+
+		    if (vstart == 0 && vend == 0) {
+			newnet = create_net(netlist);
+			newnet->name = strdup(token);
+			hash_insert(&nettable, newnet->name, NULL, newnet);
+
+			testconn = (connptr)malloc(sizeof(connect));
+			testconn->refnet = newnet;
+			testconn->refpin = NULL;	// No associated pin
+			testconn->refinst = NULL;	// No associated instance
+			testconn->index = -1;
+			testconn->vectors = NULL;
+
+			if (isinput) {			// driver (input)
+			    testconn->next = *inputlist;
+			    *inputlist = testconn;
+			}
+			else {				// receiver (output)
+			    testconn->next = *outputlist;
+			    *outputlist = testconn;
+			}
+		    }
+		    else {
+			vtarget = vend + (vstart < vend) ? 1 : -1;
+			while (vstart != vtarget) {
+			    newnet = create_net(netlist);
+			    newnet->name = (char *)malloc(strlen(token) + 6);
+			    sprintf(newnet->name, "%s[%d]", token, vstart);
+			    hash_insert(&nettable, newnet->name, NULL, newnet);
+
+			    vstart += (vtarget > vend) ? 1 : -1;
+
+			    testconn = (connptr)malloc(sizeof(connect));
+			    testconn->refnet = newnet;
+			    testconn->refpin = NULL;	// No associated pin
+			    testconn->refinst = NULL;	// No associated instance
+			    testconn->index = -1;
+			    testconn->vectors = NULL;
+
+			    if (isinput) {		// driver (input)
+				testconn->next = *inputlist;
+				*inputlist = testconn;
+			    }
+			    else {			// receiver (output)
+				testconn->next = *outputlist;
+				*outputlist = testconn;
+			    }
+			}
+		    }
+		    token = advancetoken(fsrc, ';');	// Get rest of input/output entry
+		    break;
+		}
+
+		/* Drop through on anything that isn't an input, output, or blank line */
+
+	    case GATELIST:
+
+		if (!strcasecmp(token, "endmodule")) {
+		    section = MODULE;
+		    break;    
+		}
+
+		/* Confirm that the token is a known cell, and continue parsing line if so */
+		/* Otherwise, parse to semicolon line end and continue */
+
+		testcell = (cellptr)hash_lookup(&celltable, token, NULL);
+
+		if (testcell != NULL) {
+		    section = INSTANCE;
+		    newinst = (instptr)malloc(sizeof(instance));
+		    newinst->next = *instlist;
+		    *instlist = newinst;
+		    newinst->name = NULL;
+		    newinst->refcell = testcell;
+		    newinst->in_connects = NULL;
+		    newinst->out_connects = NULL;
+		}
+		else {
+		    /* Ignore all wire and assign statements	*/
+		    /* Qflow does not generate these, but other	*/
+		    /* synthesis tools may.			*/
+
+		    if (!strcasecmp(token, "assign") && (verbose > 0)) {
+			fprintf(stdout, "Wire assignments are not handled!\n");
+		    }
+		    else if (strcasecmp(token, "wire") && (verbose > 0)) {
+			fprintf(stdout, "Unknown cell \"%s\" instanced.\n",
+				token);
+		    }
+		    token = advancetoken(fsrc, ';');	// Get rest of entry, and ignore
+		}
+		break;
+
+	    case INSTANCE:
+		newinst->name = strdup(token);
+		token = advancetoken(fsrc, '(');	// Find beginning of pin list
+		section = INSTPIN;
+		break;
+
+	    case INSTPIN:
+		if (*token == '.') {
+		    newconn = (connptr)malloc(sizeof(connect));
+		    // Pin name is in (token + 1)
+		    testpin = (pinptr)hash_lookup(&pintable, token + 1, testcell);
+		    // Sanity check
+		    if (testpin == NULL) {
+			fprintf(stderr, "No such pin \"%s\" in cell \"%s\"!\n",
+				token + 1, testcell->name);
+		    }
+		    else {
+			if (testpin->type & OUTPUT) {
+			    newconn->next = newinst->out_connects;
+			    newinst->out_connects = newconn;
+			}
+			else {
+			    newconn->next = newinst->in_connects;
+			    newinst->in_connects = newconn;
+			}
+		    }
+		    newconn->refinst = newinst;
+		    newconn->refpin = testpin;
+		    newconn->refnet = NULL;
+		    newconn->index = -1;
+		    newconn->vectors = NULL;
+		    token = advancetoken(fsrc, '(');	// Read to beginning of pin name
+		    section = PINCONN;
+		}
+		else if (*token == ';') {
+		    // End of instance record
+		    section = GATELIST;
+		}
+		else if (*token != ',' && *token != ')') {
+		    fprintf(stderr, "Unexpected entry in instance pin connection list!\n");
+		    token = advancetoken(fsrc, ';');	// Read to end-of-line
+		    section = GATELIST;
+		}
+		break;
+
+	    case PINCONN:
+		// Token is net name
+		testnet = (netptr)hash_lookup(&nettable, token, NULL);
+		if (testnet == NULL) {
+		    // This is a new net, and we need to record it
+		    newnet = create_net(netlist);
+		    newnet->name = strdup(token);
+		    hash_insert(&nettable, newnet->name, NULL, newnet);
+		    newconn->refnet = newnet;
+		}
+		else
+		    newconn->refnet = testnet;
+		section = INSTPIN;
+		break;
+	}
+	if (section == PINCONN)
+	    token = advancetoken(fsrc, ')');	// Name token parsing
+	else
+	    token = advancetoken(fsrc, 0);
+    }
+
+    fsrc->onerror = NULL;
+    hash_free(&celltable);
+    hash_free(&pintable);
+    hash_free(&nettable);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Go through the list of receivers of net "testnet" and add	*/
+/* the contributions of each to the total load.  This is either	*/
+/* the input pin capacitance, if the receiver is a pin, or the	*/
+/* designated output load (given on the command line), if the	*/
+/* receiver is an output pin.					*/
+/*--------------------------------------------------------------*/
+
+static void
+compute_net_load(netptr testnet, double out_load)
+{
+    connptr testconn;
+    pinptr testpin;
+    int i;
+
+    testnet->loadr = 0.0;
+    testnet->loadf = 0.0;
+    for (i = 0; i < testnet->fanout; i++) {
+	testconn = testnet->receivers[i];
+	testpin = testconn->refpin;
+	if (testpin == NULL) {
+	    testnet->loadr += out_load;
+	    testnet->loadf += out_load;
+	}
+	else {
+	    testnet->loadr += testpin->capr;
+	    testnet->loadf += testpin->capf;
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Discard the collapsed vectors of instance input connection	*/
+/* "testconn" after a change to its pin or to the load on the	*/
+/* instance output.  They are made again at first use.		*/
+/*--------------------------------------------------------------*/
+
+static void
+reset_connection(connptr testconn)
+{
+    testconn->vectors = NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the total load on each net (see compute_net_load()).	*/
+/* The lookup tables of each instance input pin are collapsed	*/
+/* to vectors at the load on the instance output when the pin	*/
+/* is first timed (see collapse_connection()), so the vectors	*/
+/* of any earlier loads are discarded here.			*/
+/*--------------------------------------------------------------*/
+
+static void
+computeLoads(netptr netlist, instptr instlist, double out_load)
+{
+    instptr testinst;
+    netptr testnet;
+    connptr testconn;
+
+    for (testnet = netlist; testnet; testnet = testnet->next)
+	compute_net_load(testnet, out_load);
+
+    for (testinst = instlist; testinst; testinst = testinst->next)
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+	    reset_connection(testconn);
+}
+
+/*--------------------------------------------------------------*/
+/* Record the load on the output of each instance of		*/
+/* "instlist" in the library of process corner "cn", computed	*/
+/* with that library's pin capacitances as compute_net_load()	*/
+/* does for the first library, on each input connection of the	*/
+/* instance.  The collapsed vectors of any earlier loads are	*/
+/* discarded (see computeLoads()).				*/
+/*--------------------------------------------------------------*/
+
+static void
+compute_corner_loads(corner *cn, tgraph *graph, instptr instlist,
+		double out_load)
+{
+    cornerconn *cconn;
+    pinptr     testpin;
+    instptr    testinst;
+    connptr    testconn;
+    netptr     loadnet;
+    double     loadr, loadf;
+    int	       i;
+
+    for (testinst = instlist; testinst; testinst = testinst->next) {
+	loadnet = (testinst->out_connects) ? testinst->out_connects->refnet : NULL;
+
+	loadr = loadf = 0.0;
+	for (i = 0; loadnet && (i < loadnet->fanout); i++) {
+	    testpin = CORNER_PIN(cn, loadnet->receivers[i]);
+	    if (testpin == NULL) {
+		loadr += out_load;
+		loadf += out_load;
+	    }
+	    else {
+		loadr += testpin->capr;
+		loadf += testpin->capf;
+	    }
+	}
+
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    if ((testconn->index < 0) || (testconn->index >= graph->numnodes) ||
+			(graph->nodes[testconn->index] != testconn))
+		continue;
+	    cconn = cn->conns + testconn->index;
+	    cconn->loadr = loadr;
+	    cconn->loadf = loadf;
+	    cconn->vectors = NULL;
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Set up the timing data of an additional process corner with	*/
+/* library "cells" (read from liberty file "name") for the	*/
+/* design with timing graph "graph".  Each connection is given	*/
+/* the pin of the same name in the corner library, and the	*/
+/* load on the instance output computed with that library's	*/
+/* pin capacitances, as computeLoads() does for the library	*/
+/* the netlist was read with.  The netlist itself		*/
+/* is shared.  Return NULL if the library is missing any cell	*/
+/* or pin used by the design.					*/
+/*--------------------------------------------------------------*/
+
+static corner *
+create_corner(char *name, lutable *tables, cell *cells, tgraph *graph,
+		instptr instlist, double out_load)
+{
+    corner     *cn;
+    cellptr    testcell;
+    pinptr     testpin;
+    connptr    testconn;
+    hashtable  celltable, pintable;
+    int	       i, errors;
+
+    cn = (corner *)malloc(sizeof(corner));
+    cn->name = name;
+    cn->tables = tables;
+    cn->cells = cells;
+    cn->conns = (cornerconn *)calloc(graph->numconns, sizeof(cornerconn));
+
+    // Index the cells and their pins by name, as verilogRead() does
+
+    hash_init(&celltable, 256, 1);
+    hash_init(&pintable, 1024, 0);
+    for (testcell = cells; testcell; testcell = testcell->next) {
+	if (hash_lookup(&celltable, testcell->name, NULL) == NULL)
+	    hash_insert(&celltable, testcell->name, NULL, testcell);
+	for (testpin = testcell->pins; testpin; testpin = testpin->next)
+	    hash_insert(&pintable, testpin->name, testcell, testpin);
+    }
+
+    errors = 0;
+    for (i = 0; i < graph->numconns; i++) {
+	testconn = graph->nodes[i];
+	if (testconn->refpin == NULL) continue;
+	testcell = (cellptr)hash_lookup(&celltable, testconn->refpin->refcell->name,
+			NULL);
+	testpin = (testcell) ? (pinptr)hash_lookup(&pintable, testconn->refpin->name,
+			testcell) : NULL;
+	if (testpin == NULL) {
+	    if (errors++ == 0)
+		fprintf(stderr, "Corner %s:  No pin %s of cell %s in library.\n",
+			name, testconn->refpin->name, testconn->refpin->refcell->name);
+	}
+	cn->conns[i].pin = testpin;
+    }
+    hash_free(&celltable);
+    hash_free(&pintable);
+
+    if (errors > 0) {
+	fprintf(stderr, "Corner %s:  %d pins not found;  corner not timed.\n",
+		name, errors);
+	free(cn->conns);
+	free(cn);
+	return NULL;
+    }
+
+    // The tables of each input pin are collapsed at the load in the
+    // corner library when the pin is first timed, as for the first
+    // library.
+
+    compute_corner_loads(cn, graph, instlist, out_load);
+    return cn;
+}
+
+/*--------------------------------------------------------------*/
+/* Assign types to each net.  This identifies which nets are	*/
+/* clock inputs, which are latch enable inputs, and which are	*/
+/* asynchronous set/reset inputs,.				*/
+/*								*/
+/* Whenever a clock input to a flop is found, add the		*/
+/* connection record to clockedlist				*/
+/*								*/
+/* For diagnostics, return the number of entries in clockedlist	*/
+/*--------------------------------------------------------------*/
+
+static int assign_net_types(netptr netlist, connlistptr *clockedlist)
+{
+    int i, numterms;
+    netptr testnet;
+    connptr testrcvr;
+    pinptr testpin;
+    connlistptr newclocked;
+
+    numterms = 0;
+
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	for (i = 0; i < testnet->fanout; i++) {
+	    testrcvr = testnet->receivers[i];
+	    testpin = testrcvr->refpin;
+	    if (testpin == NULL)
+		testnet->type |= OUTTERM;
+	    else {
+		switch (testpin->type & (DFFMASK | LATCHMASK)) {
+		    case DFFCLK:
+			testnet->type |= CLOCK;
+			newclocked = (connlistptr)malloc(sizeof(connlist));
+			newclocked->connection = testrcvr;
+			newclocked->next = *clockedlist;
+			*clockedlist = newclocked;
+			numterms++;
+			break;
+		    case DFFIN:
+			testnet->type |= TERMINAL;
+			break;
+		    case DFFSET:
+		    case DFFRST:
+			testnet->type |= ASYNC;
+			break;
+		    case LATCHIN:
+			testnet->type |= LATCHTERM;
+			break;
+		    case LATCHEN:
+			testnet->type |= ENABLE;
+			break;
+		}
+	    }
+	}
+    }
+    return numterms;
+}
+
+/*--------------------------------------------------------------*/
+/* Create the links representing the netlist connections.	*/
+/*								*/
+/* The verilogRead() routine added all nets and instances, and	*/
+/* for each instance, generated a list of net connections to	*/
+/* each pin.  To make the netlist easily traversible, this	*/
+/* routine does the following:					*/
+/*								*/
+/* For each instance, work through the list of pin		*/
+/*	connections.  If the pin is an output, then add the	*/
+/*	connection as the net's driver entry.  If the pin is	*/
+/*	an input, then add the connection to the list of the	*/
+/*	net's receivers, and increment the net's fanout.	*/
+/*								*/
+/* For each module input, add the input connection as the	*/
+/*	net's driver (flag an error if the net already has a	*/
+/*	driver).						*/
+/*								*/
+/* For each module output, add the output connection as one of	*/
+/*	the net's receivers (it may be the only one).		*/
+/*								*/
+/*--------------------------------------------------------------*/
+
+static void
+createLinks(netptr netlist, instptr instlist, connptr inputlist, connptr outputlist)
+{
+    netptr testnet;
+    instptr testinst;
+    connptr testconn, *receivers;
+    long total;
+
+    // Count the receivers on each net, then give each net its own
+    // section of a single array of receivers.
+
+    for (testinst = instlist; testinst; testinst = testinst->next)
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+	    testconn->refnet->fanout++;
+    for (testconn = outputlist; testconn; testconn = testconn->next)
+	testconn->refnet->fanout++;
+
+    total = 0;
+    for (testnet = netlist; testnet; testnet = testnet->next)
+	total += testnet->fanout;
+    receivers = (connptr *)malloc(total * sizeof(connptr));
+
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	testnet->receivers = (testnet->fanout > 0) ? receivers : NULL;
+	receivers += testnet->fanout;
+	testnet->fanout = 0;
+    }
+
+    for (testinst = instlist; testinst; testinst = testinst->next) {
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    testnet = testconn->refnet;
+	    testnet->receivers[testnet->fanout++] = testconn;
+	} 
+
+	for (testconn = testinst->out_connects; testconn; testconn = testconn->next) {
+	    testnet = testconn->refnet;
+	    testnet->driver = testconn;
+	} 
+    }
+
+    for (testconn = inputlist; testconn; testconn = testconn->next) {
+	testnet = testconn->refnet;
+	if (testnet->driver != NULL)
+	    fprintf(stderr, "Error:  Input pin \"%s\" has an internal driver!\n",
+			testnet->name);
+	// else
+	//    testnet->driver = testconn;	// Don't do this, makes connectivity circular
+    }
+
+    for (testconn = outputlist; testconn; testconn = testconn->next) {
+	testnet = testconn->refnet;
+	testnet->receivers[testnet->fanout++] = testconn;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Return the net that a signal arriving at "testconn" drives,	*/
+/* or NULL if it does not drive anything.  Used to generate the	*/
+/* timing graph arcs.  Module inputs have indexes of numnodes	*/
+/* and above;  module outputs do not drive anything.		*/
+/*--------------------------------------------------------------*/
+
+static netptr connect_fanout_net(tgraph *graph, connptr testconn)
+{
+    instptr testinst;
+
+    testinst = testconn->refinst;
+    if (testinst != NULL)
+	return (testinst->out_connects) ? testinst->out_connects->refnet : NULL;
+    else if (testconn->index >= graph->numnodes)
+	return testconn->refnet;
+    else
+	return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Read the loop breaks (option -b) from file "filename":  the	*/
+/* input pins, as "instance/pin", at which combinational loops	*/
+/* are broken in preference to the arcs find_graph_loops()	*/
+/* would choose.  Names are separated by white space, and a	*/
+/* line beginning with "#" is a comment.  Return the number of	*/
+/* pins read, or -1 if the file cannot be read.			*/
+/*--------------------------------------------------------------*/
+
+static int
+read_loop_breaks(char *filename)
+{
+    FILE *fbrk;
+    char line[1024], *token;
+    int count = 0;
+
+    fbrk = fopen(filename, "r");
+    if (fbrk == NULL) {
+	fprintf(stderr, "Cannot open %s for reading\n", filename);
+	return -1;
+    }
+    while (fgets(line, sizeof(line), fbrk) != NULL) {
+	if (line[0] == '#') continue;
+	for (token = strtok(line, " \t\n"); token; token = strtok(NULL, " \t\n")) {
+	    token = strdup(token);
+	    hash_insert(&loopbreaks, token, NULL, token);
+	    count++;
+	}
+    }
+    fclose(fbrk);
+    return count;
+}
+
+/*--------------------------------------------------------------*/
+/* Return 1 if node "node" of the timing graph is an input pin	*/
+/* named in the loop breaks (option -b), as "instance/pin".	*/
+/*--------------------------------------------------------------*/
+
+static int
+is_loop_break(tgraph *graph, int node)
+{
+    connptr testconn = graph->nodes[node];
+    char *name;
+    int found;
+
+    if ((loopbreaks.count == 0) || (testconn->refinst == NULL)) return 0;
+
+    name = (char *)malloc(strlen(testconn->refinst->name) +
+		strlen(testconn->refpin->name) + 2);
+    sprintf(name, "%s/%s", testconn->refinst->name, testconn->refpin->name);
+    found = (hash_lookup(&loopbreaks, name, NULL) != NULL);
+    free(name);
+    return found;
+}
+
+/*--------------------------------------------------------------*/
+/* Warn about each of the loop breaks (option -b) that names	*/
+/* no input pin of the netlist of timing graph "graph", as the	*/
+/* loops it was meant to break are then broken elsewhere.	*/
+/*--------------------------------------------------------------*/
+
+static void
+check_loop_breaks(tgraph *graph)
+{
+    hashtable  matched;
+    hashentptr entry;
+    connptr    testconn;
+    char       *name, *brkname;
+    int	       i;
+
+    if (loopbreaks.count == 0) return;
+
+    hash_init(&matched, loopbreaks.count, 0);
+    for (i = 0; i < graph->numnodes; i++) {
+	testconn = graph->nodes[i];
+	if (testconn->refinst == NULL) continue;
+	name = (char *)malloc(strlen(testconn->refinst->name) +
+		strlen(testconn->refpin->name) + 2);
+	sprintf(name, "%s/%s", testconn->refinst->name, testconn->refpin->name);
+	brkname = (char *)hash_lookup(&loopbreaks, name, NULL);
+	if ((brkname != NULL) && (hash_lookup(&matched, brkname, NULL) == NULL))
+	    hash_insert(&matched, brkname, NULL, brkname);
+	free(name);
+    }
+
+    for (i = 0; i < loopbreaks.size; i++)
+	for (entry = loopbreaks.bins[i]; entry; entry = entry->next)
+	    if (hash_lookup(&matched, entry->name, NULL) == NULL)
+		fprintf(stderr, "Loop break %s is not an input pin of "
+			"the netlist;  ignored.\n", entry->name);
+    hash_free(&matched);
+}
+
+/*--------------------------------------------------------------*/
+/* Find the combinational loops of timing graph "graph", which	*/
+/* are the strongly connected components of the propagating	*/
+/* nodes (found by Tarjan's algorithm), and choose the arcs	*/
+/* that break them.  Arcs into the pins named in the loop	*/
+/* breaks are cut first.  Any loop remaining in a component is	*/
+/* broken at the arc that closes it in a depth-first search of	*/
+/* the component, starting from its lowest numbered node.	*/
+/* Nodes and arcs are always taken in index order, so the arcs	*/
+/* cut depend only on the netlist and the loop breaks, and not	*/
+/* on the order in which paths are searched.			*/
+/*								*/
+/* "prop" is set for each propagating node.  On return, "cut"	*/
+/* is set for each arc to be removed, and the number of		*/
+/* components with loops is returned.				*/
+/*--------------------------------------------------------------*/
+
+static int
+find_graph_loops(tgraph *graph, char *prop, char *cut)
+{
+    int	    *index, *low, *comp, *tstack, *stack, *nextarc;
+    int	    *members, *compstart;
+    char    *state;
+    int	    n = graph->numnodes;
+    int	    counter, tsp, sp, numcomps, numsccs;
+    int	    i, j, c, m, node, dest, member;
+
+    index = (int *)malloc(n * sizeof(int));
+    low = (int *)malloc((n + 1) * sizeof(int));
+    comp = (int *)malloc(n * sizeof(int));
+    tstack = (int *)malloc(n * sizeof(int));
+    stack = (int *)malloc(n * sizeof(int));
+    nextarc = (int *)malloc(n * sizeof(int));
+    state = (char *)calloc(n, sizeof(char));
+
+    for (i = 0; i < n; i++) {
+	index[i] = -1;
+	comp[i] = -1;
+    }
+
+    // Tarjan's algorithm, with an explicit stack.  "tstack" holds the
+    // nodes not yet assigned to a component;  "state" is 1 for those.
+
+    counter = 0;
+    numcomps = 0;
+    tsp = 0;
+    for (i = 0; i < n; i++) {
+	if (!prop[i] || (index[i] >= 0)) continue;
+
+	sp = 0;
+	stack[0] = i;
+	nextarc[0] = graph->arcstart[i];
+	index[i] = low[i] = counter++;
+	tstack[tsp++] = i;
+	state[i] = 1;
+	while (sp >= 0) {
+	    node = stack[sp];
+	    if (nextarc[sp] < graph->arcstart[node + 1]) {
+		dest = graph->arcs[nextarc[sp]++];
+		if ((dest >= n) || !prop[dest]) continue;
+		if (index[dest] < 0) {
+		    sp++;
+		    stack[sp] = dest;
+		    nextarc[sp] = graph->arcstart[dest];
+		    index[dest] = low[dest] = counter++;
+		    tstack[tsp++] = dest;
+		    state[dest] = 1;
+		}
+		else if (state[dest] == 1) {
+		    if (index[dest] < low[node]) low[node] = index[dest];
+		}
+	    }
+	    else {
+		if (low[node] == index[node]) {
+		    do {
+			member = tstack[--tsp];
+			state[member] = 0;
+			comp[member] = numcomps;
+		    } while (member != node);
+		    numcomps++;
+		}
+		sp--;
+		if ((sp >= 0) && (low[node] < low[stack[sp]]))
+		    low[stack[sp]] = low[node];
+	    }
+	}
+    }
+
+    // Cut the arcs within a component that end at a loop break.  A
+    // component of one node is a loop only if the node drives itself.
+
+    for (node = 0; node < n; node++) {
+	if (comp[node] < 0) continue;
+	for (j = graph->arcstart[node]; j < graph->arcstart[node + 1]; j++) {
+	    dest = graph->arcs[j];
+	    if ((dest >= n) || (comp[dest] != comp[node])) continue;
+	    if ((dest == node) || is_loop_break(graph, dest)) cut[j] = 1;
+	}
+    }
+
+    // List the nodes of each component, in index order ("index" and
+    // "low" are reused for the list and the start of each component)
+
+    members = index;
+    compstart = low;
+    memset(compstart, 0, (numcomps + 1) * sizeof(int));
+    for (node = 0; node < n; node++)
+	if (comp[node] >= 0) compstart[comp[node] + 1]++;
+    for (c = 0; c < numcomps; c++)
+	compstart[c + 1] += compstart[c];
+    memcpy(tstack, compstart, numcomps * sizeof(int));
+    for (node = 0; node < n; node++)
+	if (comp[node] >= 0) members[tstack[comp[node]]++] = node;
+
+    // Depth-first search of each component, cutting the arcs back to
+    // a node on the search stack.  Nodes not reached from the first
+    // (once the loop breaks are cut) start searches of their own.
+    // "state" is 0 for unvisited nodes, 1 for nodes on the search
+    // stack, and 2 for nodes that are finished.
+
+    numsccs = 0;
+    for (c = 0; c < numcomps; c++) {
+	if (compstart[c + 1] - compstart[c] == 1) {
+	    node = members[compstart[c]];
+	    for (j = graph->arcstart[node]; j < graph->arcstart[node + 1]; j++)
+		if (graph->arcs[j] == node) break;
+	    if (j < graph->arcstart[node + 1]) numsccs++;
+	    continue;
+	}
+	numsccs++;
+
+	for (m = compstart[c]; m < compstart[c + 1]; m++) {
+	    member = members[m];
+	    if (state[member] != 0) continue;
+	    sp = 0;
+	    stack[0] = member;
+	    nextarc[0] = graph->arcstart[member];
+	    state[member] = 1;
+	    while (sp >= 0) {
+		node = stack[sp];
+		if (nextarc[sp] < graph->arcstart[node + 1]) {
+		    j = nextarc[sp]++;
+		    dest = graph->arcs[j];
+		    if (cut[j] || (dest >= n) || (comp[dest] != c)) continue;
+		    if (state[dest] == 1)
+			cut[j] = 1;		// Arc closes a loop
+		    else if (state[dest] == 0) {
+			state[dest] = 1;
+			sp++;
+			stack[sp] = dest;
+			nextarc[sp] = graph->arcstart[dest];
+		    }
+		}
+		else {
+		    state[node] = 2;
+		    sp--;
+		}
+	    }
+	}
+    }
+
+    free(index);
+    free(low);
+    free(comp);
+    free(tstack);
+    free(stack);
+    free(nextarc);
+    free(state);
+    return numsccs;
+}
+
+/*--------------------------------------------------------------*/
+/* Report the combinational loops found in timing graph "graph"	*/
+/* and the arcs removed to break them.				*/
+/*--------------------------------------------------------------*/
+
+static void
+report_graph_loops(FILE *out, tgraph *graph)
+{
+    connptr fromconn, toconn;
+    int i;
+
+    if (graph->numsccs == 0) return;
+
+    fprintf(out, "Found %d combinational loop%s, broken at %d arc%s:\n",
+		graph->numsccs, (graph->numsccs == 1) ? "" : "s",
+		graph->numloops, (graph->numloops == 1) ? "" : "s");
+    for (i = 0; i < graph->numloops; i++) {
+	fromconn = graph->nodes[graph->loopfrom[i]];
+	toconn = graph->nodes[graph->loopto[i]];
+	fprintf(out, "   %s/%s to %s/%s\n", fromconn->refinst->name,
+		fromconn->refpin->name, toconn->refinst->name, toconn->refpin->name);
+    }
+    fprintf(out, "\n");
+}
+
+/*--------------------------------------------------------------*/
+/* Build the levelized timing graph from the net receiver	*/
+/* lists generated by createLinks().  Every receiver becomes a	*/
+/* node of the graph.  Combinational loops are found and broken	*/
+/* by find_graph_loops(), and the arcs that break them are	*/
+/* removed from the graph, for both the levelized search and	*/
+/* find_path_delay().  The propagating nodes (gate inputs) are	*/
+/* then sorted into topological order by a depth-first search.	*/
+/*								*/
+/* The module inputs in "inputlist" are also given indexes,	*/
+/* after the receivers, for use by the depth-first search.	*/
+/*--------------------------------------------------------------*/
+
+static tgraph *
+build_timing_graph(netptr netlist, connlistptr inputlist)
+{
+    tgraph  *graph;
+    netptr  testnet, loadnet;
+    connptr testconn;
+    connlistptr testlink;
+    searchcount counts;
+    char    *state, *prop, *cut;
+    int	    *stack, *nextarc;
+    int	    i, j, k, n, sp, node, dest;
+
+    graph = (tgraph *)malloc(sizeof(tgraph));
+
+    // Assign an index to each receiver, then to each module input
+
+    n = 0;
+    for (testnet = netlist; testnet; testnet = testnet->next)
+	n += testnet->fanout;
+    graph->numnodes = n;
+    for (testlink = inputlist; testlink; testlink = testlink->next)
+	n++;
+    graph->numconns = n;
+
+    graph->nodes = (connptr *)malloc(n * sizeof(connptr));
+
+    n = 0;
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	for (i = 0; i < testnet->fanout; i++) {
+	    testconn = testnet->receivers[i];
+	    testconn->index = n;
+	    graph->nodes[n++] = testconn;
+	}
+    }
+    for (testlink = inputlist; testlink; testlink = testlink->next) {
+	testconn = testlink->connection;
+	testconn->index = n;
+	graph->nodes[n++] = testconn;
+    }
+
+    // Generate the fanout arcs, counting them first
+
+    graph->arcstart = (int *)malloc((n + 1) * sizeof(int));
+    graph->arcstart[0] = 0;
+    for (i = 0; i < n; i++) {
+	loadnet = connect_fanout_net(graph, graph->nodes[i]);
+	graph->arcstart[i + 1] = graph->arcstart[i] + ((loadnet) ? loadnet->fanout : 0);
+    }
+    graph->arcs = (int *)malloc(graph->arcstart[n] * sizeof(int));
+    for (i = 0; i < n; i++) {
+	loadnet = connect_fanout_net(graph, graph->nodes[i]);
+	if (loadnet == NULL) continue;
+	for (j = 0; j < loadnet->fanout; j++)
+	    graph->arcs[graph->arcstart[i] + j] = loadnet->receivers[j]->index;
+    }
+
+    // Break the combinational loops, and remove the arcs cut
+
+    prop = (char *)malloc(graph->numnodes * sizeof(char));
+    for (i = 0; i < graph->numnodes; i++)
+	prop[i] = (propagate_net(graph->nodes[i]) != NULL);
+    cut = (char *)calloc(graph->arcstart[n] + 1, sizeof(char));
+    graph->numsccs = find_graph_loops(graph, prop, cut);
+
+    graph->numloops = 0;
+    for (i = 0; i < graph->arcstart[n]; i++)
+	graph->numloops += cut[i];
+    graph->loopfrom = (int *)malloc((graph->numloops + 1) * sizeof(int));
+    graph->loopto = (int *)malloc((graph->numloops + 1) * sizeof(int));
+
+    k = 0;
+    graph->numloops = 0;
+    for (i = 0; i < n; i++) {
+	j = graph->arcstart[i];
+	graph->arcstart[i] = k;
+	for (; j < graph->arcstart[i + 1]; j++) {
+	    if (cut[j]) {
+		graph->loopfrom[graph->numloops] = i;
+		graph->loopto[graph->numloops++] = graph->arcs[j];
+	    }
+	    else
+		graph->arcs[k++] = graph->arcs[j];
+	}
+    }
+    graph->arcstart[n] = k;
+    free(cut);
+
+    memset(&counts, 0, sizeof(searchcount));
+    counts.loops = graph->numloops;
+    profile_add_counts(&counts);
+
+    // Generate the fanin arcs (the same arcs, indexed by destination)
+    // for the incremental update of the levelized search
+
+    graph->instart = (int *)calloc(graph->numnodes + 1, sizeof(int));
+    for (i = 0; i < graph->arcstart[n]; i++)
+	graph->instart[graph->arcs[i] + 1]++;
+    for (i = 0; i < graph->numnodes; i++)
+	graph->instart[i + 1] += graph->instart[i];
+    graph->inarcs = (int *)malloc(graph->arcstart[n] * sizeof(int));
+    nextarc = (int *)malloc(graph->numnodes * sizeof(int));
+    memcpy(nextarc, graph->instart, graph->numnodes * sizeof(int));
+    for (i = 0; i < n; i++)
+	for (j = graph->arcstart[i]; j < graph->arcstart[i + 1]; j++)
+	    graph->inarcs[nextarc[graph->arcs[j]]++] = i;
+    free(nextarc);
+    n = graph->numnodes;
+
+    // Depth-first search for the topological order.  "state" is 0 for
+    // unvisited nodes, 1 for nodes on the search stack, and 2 for nodes
+    // that are finished.  Nodes are recorded in post-order, then the
+    // order is reversed.  With the loops broken, no arc leads back to
+    // a node on the search stack.
+
+    graph->order = (int *)malloc(n * sizeof(int));
+    graph->pos = (int *)malloc(n * sizeof(int));
+    graph->numorder = 0;
+
+    state = (char *)calloc(n, sizeof(char));
+    stack = (int *)malloc(n * sizeof(int));
+    nextarc = (int *)malloc(n * sizeof(int));
+
+    for (i = 0; i < n; i++) {
+	if ((state[i] != 0) || !prop[i]) continue;
+
+	sp = 0;
+	stack[0] = i;
+	nextarc[0] = 0;
+	state[i] = 1;
+	while (sp >= 0) {
+	    node = stack[sp];
+	    if (graph->arcstart[node] + nextarc[sp] < graph->arcstart[node + 1]) {
+		dest = graph->arcs[graph->arcstart[node] + nextarc[sp]++];
+		if ((state[dest] == 0) && prop[dest]) {
+		    state[dest] = 1;
+		    sp++;
+		    stack[sp] = dest;
+		    nextarc[sp] = 0;
+		}
+	    }
+	    else {
+		state[node] = 2;
+		graph->order[graph->numorder++] = node;
+		sp--;
+	    }
+	}
+    }
+    free(state);
+    free(stack);
+    free(nextarc);
+    free(prop);
+
+    // Reverse the post-order.  Endpoints are placed after all
+    // propagating nodes.
+
+    for (i = 0; i < graph->numorder / 2; i++) {
+	node = graph->order[i];
+	graph->order[i] = graph->order[graph->numorder - 1 - i];
+	graph->order[graph->numorder - 1 - i] = node;
+    }
+    for (i = 0; i < n; i++)
+	graph->pos[i] = graph->numorder;
+    for (i = 0; i < graph->numorder; i++)
+	graph->pos[graph->order[i]] = i;
+
+    return graph;
+}
+
+/*--------------------------------------------------------------*/
+/* Free a timing graph made by build_timing_graph()		*/
+/*--------------------------------------------------------------*/
+
+static void
+free_timing_graph(tgraph *graph)
+{
+    free(graph->nodes);
+    free(graph->arcstart);
+    free(graph->arcs);
+    free(graph->instart);
+    free(graph->inarcs);
+    free(graph->order);
+    free(graph->pos);
+    free(graph->loopfrom);
+    free(graph->loopto);
+    free(graph);
+}
+
+/*--------------------------------------------------------------*/
+/* Path ordering used to select paths for reporting.  Return 1	*/
+/* if path "a" of "paths" is reported before path "b":  the	*/
+/* longer delay first for maximum time, and the shorter delay	*/
+/* first for minimum time.  Paths of equal delay are reported	*/
+/* in list order for maximum time and in reverse list order	*/
+/* for minimum time, as they were when the reports were taken	*/
+/* from either end of a single sorted list.			*/
+/*--------------------------------------------------------------*/
+
+static int
+path_precedes(ddataptr *paths, int a, int b, char minmax)
+{
+    if (paths[a]->delay != paths[b]->delay)
+	return TIME_WORSE(minmax, paths[a]->delay, paths[b]->delay);
+    return (minmax == MAXIMUM_TIME) ? (a < b) : (a > b);
+}
+
+/*--------------------------------------------------------------*/
+/* Place path "idx" in a bounded heap of paths, starting at	*/
+/* the root and moving down.  The root of the heap is the path	*/
+/* that would be reported last.					*/
+/*--------------------------------------------------------------*/
+
+static void
+path_heap_sift(ddataptr *paths, int *heap, int numheap, int idx, char minmax)
+{
+    int i, child;
+
+    i = 0;
+    while ((child = 2 * i + 1) < numheap) {
+	if ((child + 1 < numheap) &&
+		path_precedes(paths, heap[child], heap[child + 1], minmax))
+	    child++;
+	if (!path_precedes(paths, idx, heap[child], minmax)) break;
+	heap[i] = heap[child];
+	i = child;
+    }
+    heap[i] = idx;
+}
+
+/*--------------------------------------------------------------*/
+/* Offer path "idx" to a bounded heap of at most "count" paths.	*/
+/* If the heap is full, the path replaces the root if it is	*/
+/* reported before the root.					*/
+/*--------------------------------------------------------------*/
+
+static void
+path_heap_offer(ddataptr *paths, int *heap, int *numheap, int count, int idx,
+		char minmax)
+{
+    int i, parent;
+
+    if (*numheap < count) {
+	i = (*numheap)++;
+	while (i > 0) {
+	    parent = (i - 1) / 2;
+	    if (!path_precedes(paths, heap[parent], idx, minmax)) break;
+	    heap[i] = heap[parent];
+	    i = parent;
+	}
+	heap[i] = idx;
+    }
+    else if (path_precedes(paths, idx, heap[0], minmax))
+	path_heap_sift(paths, heap, *numheap, idx, minmax);
+}
+
+/*--------------------------------------------------------------*/
+/* Select the worst "count" paths of the "numpaths" paths in	*/
+/* "paths" (the longest for maximum time, the shortest for	*/
+/* minimum time) without sorting the whole list, and place	*/
+/* them in "result" in the order in which they are reported.	*/
+/* If "pergroup" is nonzero, no more than "pergroup" paths are	*/
+/* selected for any one endpoint.  "numnodes" is the number of	*/
+/* graph nodes, which bounds the endpoint indexes.  Return the	*/
+/* number of paths selected.					*/
+/*--------------------------------------------------------------*/
+
+static int
+select_worst_paths(ddataptr *paths, int numpaths, int count, int pergroup,
+		int numnodes, char minmax, ddataptr *result)
+{
+    int *heap, *group, *members, *nummembers;
+    int numheap, numgroups, maxgroups, node, g, i, j, k;
+
+    if ((count <= 0) || (numpaths == 0)) return 0;
+    if (count > numpaths) count = numpaths;
+    heap = (int *)malloc(count * sizeof(int));
+    numheap = 0;
+
+    if (pergroup > 0) {
+
+	// Keep the worst "pergroup" paths to each endpoint, in order,
+	// then select from those.
+
+	group = (int *)malloc(numnodes * sizeof(int));
+	for (i = 0; i < numnodes; i++) group[i] = -1;
+	maxgroups = 64;
+	numgroups = 0;
+	members = (int *)malloc(maxgroups * pergroup * sizeof(int));
+	nummembers = (int *)malloc(maxgroups * sizeof(int));
+
+	for (i = 0; i < numpaths; i++) {
+	    node = paths[i]->backtrace->receiver->index;
+	    g = group[node];
+	    if (g < 0) {
+		if (numgroups == maxgroups) {
+		    maxgroups *= 2;
+		    members = (int *)realloc(members, maxgroups * pergroup * sizeof(int));
+		    nummembers = (int *)realloc(nummembers, maxgroups * sizeof(int));
+		}
+		g = group[node] = numgroups++;
+		nummembers[g] = 0;
+	    }
+	    k = nummembers[g];
+	    if (k == pergroup) {
+		if (!path_precedes(paths, i, members[g * pergroup + k - 1], minmax))
+		    continue;
+		k--;
+	    }
+	    else
+		nummembers[g]++;
+	    for (; k > 0; k--) {
+		if (!path_precedes(paths, i, members[g * pergroup + k - 1], minmax))
+		    break;
+		members[g * pergroup + k] = members[g * pergroup + k - 1];
+	    }
+	    members[g * pergroup + k] = i;
+	}
+
+	for (g = 0; g < numgroups; g++)
+	    for (k = 0; k < nummembers[g]; k++)
+		path_heap_offer(paths, heap, &numheap, count,
+			members[g * pergroup + k], minmax);
+
+	free(group);
+	free(members);
+	free(nummembers);
+    }
+    else {
+	for (i = 0; i < numpaths; i++)
+	    path_heap_offer(paths, heap, &numheap, count, i, minmax);
+    }
+
+    // Remove paths from the heap root, which is reported last
+
+    count = numheap;
+    for (j = count - 1; j >= 0; j--) {
+	result[j] = paths[heap[0]];
+	numheap--;
+	if (numheap > 0)
+	    path_heap_sift(paths, heap, numheap, heap[numheap], minmax);
+    }
+    free(heap);
+    return count;
+}
+
+/*--------------------------------------------------------------*/
+/* Print the start point, end point, and delay of a path, on a	*/
+/* single line (without the newline).				*/
+/*--------------------------------------------------------------*/
+
+static void
+print_path(FILE *out, ddataptr testddata)
+{
+    btptr testbt;
+
+    for (testbt = testddata->backtrace; testbt->next; testbt = testbt->next);
+
+    if (testbt->receiver->refinst != NULL)
+	fprintf(out, "Path %s/%s", testbt->receiver->refinst->name,
+			testbt->receiver->refpin->name);
+    else
+	fprintf(out, "Path input pin %s", testbt->receiver->refnet->name);
+
+    if (testddata->backtrace->receiver->refinst != NULL)
+	fprintf(out, " to %s/%s", testddata->backtrace->receiver->refinst->name,
+			testddata->backtrace->receiver->refpin->name);
+    else
+	fprintf(out, " to output pin %s", testddata->backtrace->receiver->refnet->name);
+
+    fprintf(out, " delay %g ps", testddata->delay);
+}
+
+/*--------------------------------------------------------------*/
+/* Find the paths from the launch points at register clocks	*/
+/* (if "frominputs" is 0) or at module inputs (if 1), for each	*/
+/* analysis (maximum or minimum delay) in "analyses", in a	*/
+/* single search.  Paths are kept in the order found;  see	*/
+/* select_worst_paths() to pick out the worst of them.		*/
+/*								*/
+/* With the levelized search, the launch points at register	*/
+/* clocks are divided into clock domains, which are searched	*/
+/* on their own, in parallel if there is more than one thread	*/
+/* (see levelized_domain_search()).  A single sweep would keep	*/
+/* only the worst arrival at each node, whichever clock		*/
+/* launched it.  The merged result of more than one domain	*/
+/* cannot be updated incrementally, so it is not kept.		*/
+/*--------------------------------------------------------------*/
+
+static void
+search_design_paths(design *des, char frominputs, char analyses)
+{
+    pathset     *pset[2];
+    levelstate  *lstate[2];
+    partition	*parts;
+    connlistptr launchlist;
+    ddataptr    pathlist[2], testddata;
+    arena	*pool[2];
+    int		numpaths[2], numparts, depth, i;
+    char	minmax, sweep;
+
+    sweep = 0;
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	pset[minmax] = des->paths + (frominputs ? 2 : 0) +
+		((minmax == MINIMUM_TIME) ? 1 : 0);
+	lstate[minmax] = des->levels + (pset[minmax] - des->paths);
+	pool[minmax] = NULL;
+	pathlist[minmax] = NULL;
+	if (!(analyses & ANALYSIS(minmax))) continue;
+
+	arena_free(&pset[minmax]->pool);
+	if (pset[minmax]->paths != NULL) free(pset[minmax]->paths);
+	pool[minmax] = &pset[minmax]->pool;
+	if (!lstate[minmax]->valid) sweep |= ANALYSIS(minmax);
+    }
+
+    if (!des->clocks.valid) find_clock_latencies(des);
+
+    launchlist = (frominputs) ? des->inputconnlist : des->clockconnlist;
+    if (levelized) {
+	depth = (perendpoint > 1) ? perendpoint : 1;
+	parts = NULL;
+	if (sweep && !frominputs)
+	    parts = find_clock_domains(des->graph, launchlist, &numparts);
+	if (parts != NULL) {
+	    levelized_domain_search(des->graph, des->corner, &des->clocks, launchlist,
+			parts, numparts, lstate, pool, sweep, depth);
+	    free_clock_domains(parts, numparts);
+	}
+	else if (sweep)
+	    levelized_sweep(des->graph, des->corner, &des->clocks, launchlist,
+			NULL, lstate, sweep, depth);
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    if (!(analyses & ANALYSIS(minmax))) continue;
+	    numpaths[minmax] = levelized_endpoints(des->graph, lstate[minmax],
+			&pathlist[minmax], pool[minmax], minmax);
+	    if (!des->incremental || lstate[minmax]->merged)
+		free_level_state(lstate[minmax]);
+	}
+    }
+    else
+	find_clock_to_term_paths(des->graph, des->corner, &des->clocks, launchlist,
+			pathlist, pool, numpaths, analyses);
+
+    /*--------------------------------------------------*/
+    /* Collect paths into a non-linked array		*/
+    /*--------------------------------------------------*/
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	if (!(analyses & ANALYSIS(minmax))) continue;
+	pset[minmax]->numpaths = numpaths[minmax];
+	pset[minmax]->paths = (ddataptr *)malloc(numpaths[minmax] * sizeof(ddataptr));
+
+	i = 0;
+	for (testddata = pathlist[minmax]; testddata; testddata = testddata->next) {
+	   pset[minmax]->paths[i] = testddata;
+	   i++;
+	}
+	pset[minmax]->valid = 1;
+	pset[minmax]->reported = 0;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Return the paths from the launch points at register clocks	*/
+/* (if "frominputs" is 0) or at module inputs (if 1), for	*/
+/* either maximum or minimum delay.  The result is kept in the	*/
+/* design until invalidated by a change to the design, so	*/
+/* repeated queries do not repeat the search.  If the paths for	*/
+/* the other analysis are not up to date either, both are found	*/
+/* in a single search (see search_design_paths()).  The number	*/
+/* of paths is reported to "out" (if not NULL) the first time	*/
+/* they are returned.						*/
+/*--------------------------------------------------------------*/
+
+static pathset *
+find_design_paths(FILE *out, design *des, char frominputs, char minmax)
+{
+    pathset *pset, *other;
+
+    pset = des->paths + (frominputs ? 2 : 0) + ((minmax == MINIMUM_TIME) ? 1 : 0);
+    other = des->paths + (frominputs ? 2 : 0) + ((minmax == MINIMUM_TIME) ? 0 : 1);
+
+    if (!pset->valid)
+	search_design_paths(des, frominputs, (other->valid) ? ANALYSIS(minmax) :
+		BOTH_ANALYSES);
+
+    if ((out != NULL) && !pset->reported) {
+	fprintf(out, "Number of paths analyzed:  %d\n", pset->numpaths);
+	pset->reported = 1;
+    }
+    return pset;
+}
+
+/*--------------------------------------------------------------*/
+/* Discard all paths found in the design, and the slack map.	*/
+/* Called whenever the design changes in a way that affects	*/
+/* delays.							*/
+/*--------------------------------------------------------------*/
+
+static void
+invalidate_design_paths(design *des)
+{
+    int i;
+
+    des->slacks.valid = 0;
+
+    for (i = 0; i < 4; i++) {
+	arena_free(&des->paths[i].pool);
+	if (des->paths[i].paths != NULL) free(des->paths[i].paths);
+	des->paths[i].paths = NULL;
+	des->paths[i].numpaths = 0;
+	des->paths[i].valid = 0;
+	des->paths[i].reported = 0;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Discard the results of the levelized search as well as the	*/
+/* paths.  Called when the whole design must be timed again.	*/
+/*--------------------------------------------------------------*/
+
+static void
+invalidate_design_arrivals(design *des)
+{
+    int i;
+
+    invalidate_design_paths(des);
+    for (i = 0; i < 4; i++)
+	free_level_state(des->levels + i);
+    des->clocks.valid = 0;
+    des->numchanged = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Generate the full timing report:  the top "numreport"	*/
+/* maximum and minimum delay paths from register clocks, and	*/
+/* from module inputs, with the setup and hold checks.  The	*/
+/* paths are found again.					*/
+/*--------------------------------------------------------------*/
+
+static void
+report_design_timing(FILE *out, design *des)
+{
+    pathset  *pset;
+    ddataptr testddata, *worst;
+    char     badtiming;
+    double   slack;
+    int	     numworst, i;
+
+    invalidate_design_paths(des);
+    worst = (ddataptr *)malloc(numreport * sizeof(ddataptr));
+
+    /*--------------------------------------------------*/
+    /* Identify all clock-to-terminal paths		*/
+    /*--------------------------------------------------*/
+
+    pset = find_design_paths(out, des, 0, MAXIMUM_TIME);
+
+    /*--------------------------------------------------*/
+    /* Report on top maximum delay paths		*/
+    /*--------------------------------------------------*/
+
+    numworst = select_worst_paths(pset->paths, pset->numpaths, numreport,
+		perendpoint, des->graph->numnodes, MAXIMUM_TIME, worst);
+    fprintf(out, "\nTop %d maximum delay paths:\n", numworst);
+    badtiming = 0;
+    for (i = 0; i < numworst; i++) {
+	testddata = worst[i];
+	print_path(out, testddata);
+
+	if (des->period > 0.0) {
+	    slack = des->period - testddata->delay;
+	    fprintf(out, "   Slack = %g ps", slack);
+	    if (slack < 0.0) badtiming = 1;
+	}
+	fprintf(out, "\n");
+    }
+
+    if (des->period > 0.0) {
+	if (badtiming) {
+	    fprintf(out, "ERROR:  Design fails timing requirements.\n");
+	}
+	else {
+	    fprintf(out, "Design meets timing requirements.\n");
+	}
+    }
+    else if (numworst > 0) {
+	fprintf(out, "Computed maximum clock frequency (zero slack) = %g MHz\n",
+		(1.0E6 / worst[0]->delay));
+    }
+    fprintf(out, "-----------------------------------------\n\n");
+    fflush(out);
+
+    /*--------------------------------------------------*/
+    /* Now calculate minimum delay paths		*/
+    /*--------------------------------------------------*/
+
+    pset = find_design_paths(out, des, 0, MINIMUM_TIME);
+
+    /*--------------------------------------------------*/
+    /* Report on top minimum delay paths		*/
+    /*--------------------------------------------------*/
+
+    numworst = select_worst_paths(pset->paths, pset->numpaths, numreport,
+		perendpoint, des->graph->numnodes, MINIMUM_TIME, worst);
+    fprintf(out, "\nTop %d minimum delay paths:\n", numworst);
+    badtiming = 0;
+    for (i = 0; i < numworst; i++) {
+	testddata = worst[i];
+	print_path(out, testddata);
+	fprintf(out, "\n");
+
+	if (testddata->delay < 0.0) badtiming = 1;
+    }
+    if (badtiming)
+	fprintf(out, "ERROR:  Design fails minimum hold timing.\n");
+    else
+	fprintf(out, "Design meets minimum hold timing.\n");
+
+    fprintf(out, "-----------------------------------------\n\n");
+    fflush(out);
+
+    /*--------------------------------------------------*/
+    /* Identify all input-to-terminal paths		*/
+    /*--------------------------------------------------*/
+
+    pset = find_design_paths(out, des, 1, MAXIMUM_TIME);
+
+    /*--------------------------------------------------*/
+    /* Report on top maximum delay paths		*/
+    /*--------------------------------------------------*/
+
+    numworst = select_worst_paths(pset->paths, pset->numpaths, numreport,
+		perendpoint, des->graph->numnodes, MAXIMUM_TIME, worst);
+    fprintf(out, "\nTop %d maximum delay paths:\n", numworst);
+    for (i = 0; i < numworst; i++) {
+	print_path(out, worst[i]);
+	fprintf(out, "\n");
+    }
+
+    fprintf(out, "-----------------------------------------\n\n");
+    fflush(out);
+
+    /*--------------------------------------------------*/
+    /* Now calculate minimum delay paths from inputs	*/
+    /*--------------------------------------------------*/
+
+    pset = find_design_paths(out, des, 1, MINIMUM_TIME);
+
+    /*--------------------------------------------------*/
+    /* Report on top minimum delay paths		*/
+    /*--------------------------------------------------*/
+
+    numworst = select_worst_paths(pset->paths, pset->numpaths, numreport,
+		perendpoint, des->graph->numnodes, MINIMUM_TIME, worst);
+    fprintf(out, "\nTop %d minimum delay paths:\n", numworst);
+    for (i = 0; i < numworst; i++) {
+	print_path(out, worst[i]);
+	fprintf(out, "\n");
+    }
+
+    fprintf(out, "-----------------------------------------\n\n");
+    fflush(out);
+    free(worst);
+}
+
+/*--------------------------------------------------------------*/
+/* Thread timing one process corner (see report_corners()).	*/
+/*--------------------------------------------------------------*/
+
+static void *
+corner_timing_thread(void *arg)
+{
+    cornerjob *job = (cornerjob *)arg;
+
+    report_design_timing(job->out, &job->des);
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Generate the full timing report (see report_design_timing())	*/
+/* for each of "numcorners" process corners of design "des".	*/
+/* corners[0] is NULL for the library the netlist was read	*/
+/* with, and "names" holds the liberty file of each corner.	*/
+/* The corners are timed in parallel, one thread each, and	*/
+/* their reports are printed in order, followed by a summary	*/
+/* of the worst setup and hold slack of each corner.		*/
+/*--------------------------------------------------------------*/
+
+static void
+report_corners(FILE *out, design *des, corner **corners, char **names,
+		int numcorners)
+{
+    cornerjob *jobs;
+    pthread_t *tids;
+    pathset   *pset;
+    ddataptr  worst;
+    char      buffer[4096], failed;
+    size_t    n;
+    int	      c, i;
+
+    jobs = (cornerjob *)malloc(numcorners * sizeof(cornerjob));
+    tids = (pthread_t *)malloc(numcorners * sizeof(pthread_t));
+
+    for (c = 0; c < numcorners; c++) {
+	jobs[c].des = *des;
+	jobs[c].des.corner = corners[c];
+	for (i = 0; i < 4; i++) {
+	    arena_init(&jobs[c].des.paths[i].pool);
+	    jobs[c].des.paths[i].paths = NULL;
+	    jobs[c].des.paths[i].valid = 0;
+	    jobs[c].des.levels[i].valid = 0;
+	}
+	memset(&jobs[c].des.clocks, 0, sizeof(clocktree));
+	jobs[c].name = names[c];
+	jobs[c].out = tmpfile();
+	if (jobs[c].out == NULL) jobs[c].out = out;
+	pthread_create(&tids[c], NULL, corner_timing_thread, &jobs[c]);
+    }
+
+    for (c = 0; c < numcorners; c++) {
+	pthread_join(tids[c], NULL);
+	fprintf(out, "Process corner %d:  %s\n\n", c + 1, jobs[c].name);
+	if (jobs[c].out != out) {
+	    rewind(jobs[c].out);
+	    while ((n = fread(buffer, 1, sizeof(buffer), jobs[c].out)) > 0)
+		fwrite(buffer, 1, n, out);
+	    fclose(jobs[c].out);
+	}
+    }
+
+    // Summary of the register-to-register paths of each corner
+
+    fprintf(out, "Process corner summary:\n");
+    failed = 0;
+    for (c = 0; c < numcorners; c++) {
+	fprintf(out, "   %d %s:  ", c + 1, jobs[c].name);
+
+	pset = jobs[c].des.paths;
+	if (select_worst_paths(pset->paths, pset->numpaths, 1, 0,
+			des->graph->numnodes, MAXIMUM_TIME, &worst) == 0)
+	    fprintf(out, "no setup paths");
+	else if (des->period > 0.0) {
+	    fprintf(out, "setup slack %g ps", des->period - worst->delay);
+	    if (worst->delay > des->period) failed = 1;
+	}
+	else
+	    fprintf(out, "maximum delay %g ps (%g MHz)", worst->delay,
+			1.0E6 / worst->delay);
+
+	pset = jobs[c].des.paths + 1;
+	if (select_worst_paths(pset->paths, pset->numpaths, 1, 0,
+			des->graph->numnodes, MINIMUM_TIME, &worst) == 0)
+	    fprintf(out, ", no hold paths\n");
+	else {
+	    fprintf(out, ", hold slack %g ps\n", worst->delay);
+	    if (worst->delay < 0.0) failed = 1;
+	}
+	invalidate_design_paths(&jobs[c].des);
+	free_clock_tree(&jobs[c].des.clocks);
+    }
+    if (failed)
+	fprintf(out, "ERROR:  Design fails timing requirements at one or more corners.\n");
+    else
+	fprintf(out, "Design meets timing requirements at all corners.\n");
+    fprintf(out, "-----------------------------------------\n\n");
+    fflush(out);
+
+    free(jobs);
+    free(tids);
+}
+
+/*--------------------------------------------------------------*/
+/* Incremental timing after local changes to the netlist (ECO).	*/
+/* Each change recomputes the loads of the nets it touches,	*/
+/* discards the collapsed delay tables of the gates driving	*/
+/* those nets, and records the receivers whose arrival times	*/
+/* may change.  update_design_timing() then brings the		*/
+/* levelized search results up to date by propagating forward	*/
+/* from those receivers only.					*/
+/*--------------------------------------------------------------*/
+
+static void
+eco_mark(design *des, connptr testconn)
+{
+    if (des->numchanged == des->maxchanged) {
+	des->maxchanged = (des->maxchanged == 0) ? 64 : 2 * des->maxchanged;
+	des->changed = (connptr *)realloc(des->changed,
+			des->maxchanged * sizeof(connptr));
+    }
+    des->changed[des->numchanged++] = testconn;
+}
+
+/*--------------------------------------------------------------*/
+/* The receivers or the driver of net "testnet" have changed.	*/
+/* Recompute its load, discard the collapsed vectors of the	*/
+/* instance driving it, and mark its receivers.			*/
+/*--------------------------------------------------------------*/
+
+static void
+eco_net_changed(design *des, netptr testnet)
+{
+    instptr testinst;
+    connptr testconn;
+    int i;
+
+    compute_net_load(testnet, des->outload);
+
+    if (testnet->driver != NULL) {
+	testinst = testnet->driver->refinst;
+	if ((testinst != NULL) && (testinst->out_connects->refnet == testnet))
+	    for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+		reset_connection(testconn);
+    }
+    for (i = 0; i < testnet->fanout; i++)
+	eco_mark(des, testnet->receivers[i]);
+}
+
+/*--------------------------------------------------------------*/
+/* Remove connection "testconn" from the receivers of net	*/
+/* "testnet", or add it to the end of the receivers.  The	*/
+/* receiver arrays made by createLinks() are sections of a	*/
+/* single block, so a net that gains a receiver gets a new one.	*/
+/*--------------------------------------------------------------*/
+
+static void
+eco_remove_receiver(netptr testnet, connptr testconn)
+{
+    int i;
+
+    for (i = 0; i < testnet->fanout; i++)
+	if (testnet->receivers[i] == testconn) break;
+    if (i == testnet->fanout) return;
+    memmove(testnet->receivers + i, testnet->receivers + i + 1,
+		(testnet->fanout - i - 1) * sizeof(connptr));
+    testnet->fanout--;
+}
+
+static void
+eco_add_receiver(netptr testnet, connptr testconn)
+{
+    connptr *receivers;
+
+    receivers = (connptr *)malloc((testnet->fanout + 1) * sizeof(connptr));
+    if (testnet->fanout > 0)
+	memcpy(receivers, testnet->receivers, testnet->fanout * sizeof(connptr));
+    receivers[testnet->fanout++] = testconn;
+    testnet->receivers = receivers;
+}
+
+/*--------------------------------------------------------------*/
+/* Find pin "name" of cell "testcell"				*/
+/*--------------------------------------------------------------*/
+
+static pinptr
+find_cell_pin(cellptr testcell, char *name)
+{
+    pinptr testpin;
+
+    for (testpin = testcell->pins; testpin; testpin = testpin->next)
+	if (!strcmp(testpin->name, name))
+	    return testpin;
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Replace the cell of instance "testinst" with "newcell"	*/
+/* (e.g., to resize a gate).  The new cell must have a pin of	*/
+/* the same name and type for each connection of the instance.	*/
+/* Return 0 on success, -1 if the cells do not match.		*/
+/*--------------------------------------------------------------*/
+
+static int
+eco_swap_cell(design *des, instptr testinst, cellptr newcell)
+{
+    connptr testconn;
+    pinptr newpin;
+    int k;
+
+    for (k = 0; k < 2; k++) {
+	testconn = (k == 0) ? testinst->in_connects : testinst->out_connects;
+	for (; testconn; testconn = testconn->next) {
+	    newpin = find_cell_pin(newcell, testconn->refpin->name);
+	    if ((newpin == NULL) || (newpin->type != testconn->refpin->type))
+		return -1;
+	}
+    }
+
+    for (testconn = testinst->out_connects; testconn; testconn = testconn->next)
+	testconn->refpin = find_cell_pin(newcell, testconn->refpin->name);
+    for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	testconn->refpin = find_cell_pin(newcell, testconn->refpin->name);
+	reset_connection(testconn);
+    }
+    testinst->refcell = newcell;
+
+    // Input pin capacitances change the loads on the input nets;  the
+    // instance's own delay tables are collapsed again at first use.
+
+    for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+	eco_net_changed(des, testconn->refnet);
+    eco_net_changed(des, testinst->out_connects->refnet);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Move instance pin connection "testconn" to net "newnet".	*/
+/* An output pin may only be moved to a net that has no other	*/
+/* driver.  Return 0 on success, -1 if the net is driven.	*/
+/*--------------------------------------------------------------*/
+
+static int
+eco_reconnect(design *des, connptr testconn, netptr newnet)
+{
+    netptr oldnet;
+    connptr testinput;
+
+    oldnet = testconn->refnet;
+    if (oldnet == newnet) return 0;
+
+    if (testconn->refpin->type & OUTPUT) {
+	if (newnet->driver != NULL) return -1;
+	for (testinput = des->inputlist; testinput; testinput = testinput->next)
+	    if (testinput->refnet == newnet) return -1;
+
+	if (oldnet->driver == testconn) oldnet->driver = NULL;
+	testconn->refnet = newnet;
+	newnet->driver = testconn;
+    }
+    else {
+	eco_remove_receiver(oldnet, testconn);
+	eco_add_receiver(newnet, testconn);
+	testconn->refnet = newnet;
+	eco_mark(des, testconn);
+    }
+    eco_net_changed(des, oldnet);
+    eco_net_changed(des, newnet);
+    des->relink = 1;
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Insert a buffer (instance "instname" of cell "bufcell") on	*/
+/* net "testnet".  The buffer drives a new net "netname", and	*/
+/* the "numsinks" receivers in "sinks" are moved to the new	*/
+/* net.  If "numsinks" is 0, all instance pins on "testnet"	*/
+/* are moved.  Return the new instance, or NULL if "bufcell"	*/
+/* is not a single-input, single-output cell or a sink is not	*/
+/* an instance input on "testnet".				*/
+/*--------------------------------------------------------------*/
+
+static instptr
+eco_insert_buffer(design *des, netptr testnet, cellptr bufcell, char *instname,
+		char *netname, connptr *sinks, int numsinks)
+{
+    pinptr testpin, inpin, outpin;
+    instptr newinst;
+    netptr newnet;
+    connptr inconn, outconn, testconn;
+    int i, numpins;
+
+    inpin = outpin = NULL;
+    numpins = 0;
+    for (testpin = bufcell->pins; testpin; testpin = testpin->next) {
+	if (testpin->type & OUTPUT)
+	    outpin = testpin;
+	else
+	    inpin = testpin;
+	numpins++;
+    }
+    if ((numpins != 2) || (inpin == NULL) || (outpin == NULL)) return NULL;
+
+    for (i = 0; i < numsinks; i++) {
+	testconn = sinks[i];
+	if ((testconn->refnet != testnet) || (testconn->refinst == NULL) ||
+			(testconn->refpin->type & OUTPUT))
+	    return NULL;
+    }
+
+    newnet = create_net(&des->netlist);
+    newnet->name = strdup(netname);
+
+    newinst = (instptr)malloc(sizeof(instance));
+    newinst->name = strdup(instname);
+    newinst->refcell = bufcell;
+    newinst->next = des->instlist;
+    des->instlist = newinst;
+
+    inconn = (connptr)malloc(sizeof(connect));
+    inconn->refinst = newinst;
+    inconn->refpin = inpin;
+    inconn->refnet = testnet;
+    inconn->index = -1;
+    inconn->next = NULL;
+    reset_connection(inconn);
+    newinst->in_connects = inconn;
+
+    outconn = (connptr)malloc(sizeof(connect));
+    outconn->refinst = newinst;
+    outconn->refpin = outpin;
+    outconn->refnet = newnet;
+    outconn->index = -1;
+    outconn->vectors = NULL;
+    outconn->next = NULL;
+    newinst->out_connects = outconn;
+    newnet->driver = outconn;
+
+    // Move the sinks, then add the buffer input
+
+    if (numsinks == 0) {
+	for (i = 0; i < testnet->fanout; i++) {
+	    testconn = testnet->receivers[i];
+	    if (testconn->refinst == NULL) continue;
+	    eco_add_receiver(newnet, testconn);
+	    testconn->refnet = newnet;
+	}
+	for (i = 0; i < newnet->fanout; i++)
+	    eco_remove_receiver(testnet, newnet->receivers[i]);
+    }
+    else {
+	for (i = 0; i < numsinks; i++) {
+	    eco_remove_receiver(testnet, sinks[i]);
+	    eco_add_receiver(newnet, sinks[i]);
+	    sinks[i]->refnet = newnet;
+	}
+    }
+    eco_add_receiver(testnet, inconn);
+
+    eco_net_changed(des, newnet);
+    eco_net_changed(des, testnet);
+    des->relink = 1;
+    return newinst;
+}
+
+/*--------------------------------------------------------------*/
+/* Bring the timing of the design up to date after ECO		*/
+/* changes.  If the connectivity changed, the timing graph is	*/
+/* rebuilt and the levelized search results are moved to it.	*/
+/* Each levelized search result is then updated from the	*/
+/* changed receivers.  A graph with combinational loops is	*/
+/* searched again in full, as the loop arcs that are broken may	*/
+/* differ.  Return the number of graph nodes evaluated.		*/
+/*--------------------------------------------------------------*/
+
+static int
+update_design_timing(design *des)
+{
+    tgraph  *oldgraph;
+    connptr testconn;
+    int	    *dirty, numdirty, numevals, i;
+
+    oldgraph = NULL;
+    if (des->relink) {
+	oldgraph = des->graph;
+	des->graph = build_timing_graph(des->netlist, des->inputconnlist);
+	des->relink = 0;
+    }
+
+    dirty = (int *)malloc((des->numchanged + 1) * sizeof(int));
+    numdirty = 0;
+    for (i = 0; i < des->numchanged; i++) {
+	testconn = des->changed[i];
+	if ((testconn->index >= 0) && (testconn->index < des->graph->numnodes) &&
+			(des->graph->nodes[testconn->index] == testconn))
+	    dirty[numdirty++] = testconn->index;
+    }
+    des->numchanged = 0;
+
+    // Any change may move the clock arrivals, which are found again
+    // before the launch points are checked
+
+    find_clock_latencies(des);
+
+    numevals = 0;
+    for (i = 0; i < 4; i++) {
+	if (!des->levels[i].valid) continue;
+	if ((des->graph->numloops > 0) || (oldgraph && (oldgraph->numloops > 0))) {
+	    free_level_state(des->levels + i);
+	    continue;
+	}
+	if (oldgraph != NULL)
+	    remap_level_state(des->levels + i, oldgraph, des->graph);
+	numevals += levelized_update(des->graph, des->levels + i, dirty, numdirty,
+			(i & 1) ? MINIMUM_TIME : MAXIMUM_TIME);
+    }
+
+    free(dirty);
+    if (oldgraph != NULL) free_timing_graph(oldgraph);
+    invalidate_design_paths(des);
+    return numevals;
+}
+
+/*--------------------------------------------------------------*/
+/* Compare a collapsed "vector" of table "tableptr" with the	*/
+/* table collapsed again at "load".  Return 1 if they differ,	*/
+/* or 0 if they match or the vector has not been made.		*/
+/*--------------------------------------------------------------*/
+
+static int
+verify_vector(lutableptr tableptr, double load, double *vector)
+{
+    double *tmpvector;
+    int result;
+
+    if ((tableptr == NULL) || (vector == NULL)) return 0;
+
+    tmpvector = (double *)malloc(tableptr->size1 * sizeof(double));
+    table_collapse(tableptr, load, tmpvector);
+    result = (memcmp(tmpvector, vector, tableptr->size1 * sizeof(double))) ? 1 : 0;
+    free(tmpvector);
+    return result;
+}
+
+/*--------------------------------------------------------------*/
+/* Check the incrementally updated loads, delay vectors and	*/
+/* levelized search results against a full analysis of the	*/
+/* design, without changing them.  Return the number of values	*/
+/* that differ.							*/
+/*--------------------------------------------------------------*/
+
+static int
+verify_design_timing(design *des)
+{
+    netptr   testnet;
+    net	     tmpnet;
+    instptr  testinst;
+    connptr  testconn;
+    netptr   loadnet;
+    pinptr   testpin;
+    levelstate tmpstate, *tmpstates[2];
+    connlistptr launchlist;
+    int	     errors, i, k;
+
+    errors = 0;
+    for (testnet = des->netlist; testnet; testnet = testnet->next) {
+	tmpnet = *testnet;
+	compute_net_load(&tmpnet, des->outload);
+	if ((tmpnet.loadr != testnet->loadr) || (tmpnet.loadf != testnet->loadf))
+	    errors++;
+    }
+
+    for (testinst = des->instlist; testinst; testinst = testinst->next) {
+	loadnet = testinst->out_connects->refnet;
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    testpin = testconn->refpin;
+	    if (testconn->vectors == NULL) continue;
+	    errors += verify_vector(testpin->propdelr, loadnet->loadr,
+			testconn->vectors[0]);
+	    errors += verify_vector(testpin->propdelf, loadnet->loadf,
+			testconn->vectors[1]);
+	    errors += verify_vector(testpin->transr, loadnet->loadr,
+			testconn->vectors[2]);
+	    errors += verify_vector(testpin->transf, loadnet->loadf,
+			testconn->vectors[3]);
+	}
+    }
+
+    for (i = 0; i < 4; i++) {
+	if (!des->levels[i].valid) continue;
+	launchlist = (i & 2) ? des->inputconnlist : des->clockconnlist;
+	tmpstates[(i & 1) ? MINIMUM_TIME : MAXIMUM_TIME] = &tmpstate;
+	levelized_sweep(des->graph, des->corner, &des->clocks, launchlist, NULL,
+			tmpstates, ANALYSIS((i & 1) ? MINIMUM_TIME : MAXIMUM_TIME),
+			des->levels[i].depth);
+	for (k = 0; k < 2 * tmpstate.depth * des->graph->numnodes; k++)
+	    if (arrival_differs(des->levels[i].arrivals + k, tmpstate.arrivals + k))
+		errors++;
+	free_level_state(&tmpstate);
+    }
+    return errors;
+}
+
+/*--------------------------------------------------------------*/
+/* Free the slack map "smap".					*/
+/*--------------------------------------------------------------*/
+
+static void
+free_slack_map(slackmap *smap)
+{
+    if (smap->arrival != NULL) free(smap->arrival);
+    if (smap->required != NULL) free(smap->required);
+    if (smap->slack != NULL) free(smap->slack);
+    smap->arrival = NULL;
+    smap->required = NULL;
+    smap->slack = NULL;
+    smap->numconns = 0;
+    smap->valid = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the delay of the path ending at endpoint "testconn"	*/
+/* with edge direction "dir" and arrival "aptr" of the		*/
+/* levelized search "lstate", including the clock skew and the	*/
+/* setup or hold time, as terminate_path() finds it for the	*/
+/* path's delay record (see capture_path_delay()).		*/
+/*--------------------------------------------------------------*/
+
+static double
+endpoint_path_delay(levelstate *lstate, connptr testconn, short dir, arrival *aptr,
+		char minmax)
+{
+    launch    *lptr;
+    btptr     clock2list, selecteddest, freebt;
+    double    delay;
+
+    lptr = lstate->launches + aptr->launch;
+    selecteddest = find_capture_clock(lstate->clocks, testconn, &clock2list, minmax);
+    delay = capture_path_delay(lstate->corner, testconn, dir,
+		aptr->delay + ((lptr->source) ? lptr->source->delay : 0.0),
+		aptr->trans, lptr, clock2list, selecteddest, minmax, NULL);
+
+    while (clock2list != NULL) {
+	freebt = clock2list;
+	clock2list = clock2list->next;
+	free(freebt);
+    }
+    return delay;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the required time of a signal with edge direction	*/
+/* "dir" and transition time "trans" at connection "testconn"	*/
+/* (a gate input or a launch point), from the times in		*/
+/* "reqtime" (see SLACK_INDEX()) at the receivers on the	*/
+/* gate's output net (the graph arcs out of "testconn"), less	*/
+/* the gate delay to each.  The tightest is kept:  the earliest	*/
+/* for maximum time and the latest for minimum time.  If no	*/
+/* receiver has a required time, the result is			*/
+/* TIME_SIGN(minmax) * SLACK_NONE.				*/
+/*--------------------------------------------------------------*/
+
+static double
+slack_required(tgraph *graph, corner *cn, double *reqtime, connptr testconn,
+		short dir, double trans, char minmax)
+{
+    double  newdelay[2], newtrans[2], result, testreq;
+    short   outdir;
+    int	    i, node;
+
+    result = TIME_SIGN(minmax) * SLACK_NONE;
+    outdir = levelized_gate_output(cn, testconn, dir, 0.0, trans, minmax,
+		newdelay, newtrans);
+
+    for (i = graph->arcstart[testconn->index]; i < graph->arcstart[testconn->index + 1];
+		i++) {
+	node = graph->arcs[i];
+	if (outdir & RISING) {
+	    testreq = reqtime[SLACK_INDEX(node, minmax, RISING)] - newdelay[0];
+	    if (TIME_WORSE(minmax, result, testreq)) result = testreq;
+	}
+	if (outdir & FALLING) {
+	    testreq = reqtime[SLACK_INDEX(node, minmax, FALLING)] - newdelay[1];
+	    if (TIME_WORSE(minmax, result, testreq)) result = testreq;
+	}
+    }
+    return result;
+}
+
+/*--------------------------------------------------------------*/
+/* Keep the arrival and required time "newarr" and "newreq" at	*/
+/* position "idx" of "arrtime" and "reqtime" if they give a	*/
+/* worse slack than the times there.				*/
+/*--------------------------------------------------------------*/
+
+static void
+slack_merge(double *arrtime, double *reqtime, int idx, double newarr,
+		double newreq, char minmax)
+{
+    double sign = TIME_SIGN(minmax);
+
+    if (sign * (newreq - newarr) < sign * (reqtime[idx] - arrtime[idx])) {
+	arrtime[idx] = newarr;
+	reqtime[idx] = newreq;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Find the worst arrival and transition time at each graph	*/
+/* node and edge direction from the levelized search		*/
+/* "lstate" (indexed by analysis), and the worst path delay	*/
+/* of the arrivals at each endpoint (see endpoint_path_delay()).	*/
+/* Return the worst maximum path delay, or 0 if there are no	*/
+/* paths.							*/
+/*--------------------------------------------------------------*/
+
+static double
+slack_arrivals(tgraph *graph, levelstate **lstate, double *arrtime, double *trans,
+		double *pathdelay)
+{
+    arrival *aptr;
+    connptr testconn;
+    double  delay, maxdelay;
+    char    minmax;
+    short   dir, slot;
+    int	    node, idx;
+
+    maxdelay = 0.0;
+    for (node = 0; node < graph->numnodes; node++) {
+	testconn = graph->nodes[node];
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    for (dir = RISING; dir <= FALLING; dir++) {
+		aptr = NODE_ARRIVALS(lstate[minmax], node, dir);
+		if (aptr->launch < 0) continue;
+		idx = SLACK_INDEX(node, minmax, dir);
+		arrtime[idx] = aptr->delay;
+		trans[idx] = aptr->trans;
+		if (propagate_net(testconn) != NULL) continue;
+
+		// The path delay to a module output includes the clock skew
+		// of the launch point, so the worst may be in any slot
+
+		pathdelay[idx] = endpoint_path_delay(lstate[minmax], testconn, dir,
+			aptr, minmax);
+		for (slot = 1; slot < lstate[minmax]->depth; slot++) {
+		    if (aptr[slot].launch < 0) break;
+		    delay = endpoint_path_delay(lstate[minmax], testconn, dir,
+				aptr + slot, minmax);
+		    if (TIME_WORSE(minmax, delay, pathdelay[idx])) pathdelay[idx] = delay;
+		}
+		if ((minmax == MAXIMUM_TIME) && (pathdelay[idx] > maxdelay))
+		    maxdelay = pathdelay[idx];
+	    }
+	}
+    }
+    return maxdelay;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the required time at each connection for the arrivals	*/
+/* of the levelized search "lstate" (indexed by analysis), as	*/
+/* found by slack_arrivals().  At each endpoint, the required	*/
+/* time is set to give the slack of the worst path delay there	*/
+/* (the clock period "period" less the delay for setup, or the	*/
+/* delay for hold).  Required times then propagate backward in	*/
+/* reverse topological order, less the gate delay at the	*/
+/* transition time of the worst arrival.  At a launch point,	*/
+/* the arrival and required time of the paths starting there	*/
+/* are kept if their slack is the worse.			*/
+/*--------------------------------------------------------------*/
+
+static void
+slack_required_times(tgraph *graph, corner *cn, levelstate **lstate, double period,
+		double *arrtime, double *trans, double *pathdelay, double *reqtime)
+{
+    launch  *lptr;
+    double  sign, delay, slack;
+    char    minmax;
+    short   dir;
+    int	    i, node, idx;
+
+    for (node = 0; node < graph->numnodes; node++) {
+	if (propagate_net(graph->nodes[node]) != NULL) continue;
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    sign = TIME_SIGN(minmax);
+	    for (dir = RISING; dir <= FALLING; dir++) {
+		idx = SLACK_INDEX(node, minmax, dir);
+		if (arrtime[idx] == -sign * SLACK_NONE) continue;
+		if (minmax == MAXIMUM_TIME)
+		    slack = period - pathdelay[idx];
+		else
+		    slack = pathdelay[idx];
+		reqtime[idx] = arrtime[idx] + sign * slack;
+	    }
+	}
+    }
+
+    for (i = graph->numorder - 1; i >= 0; i--) {
+	node = graph->order[i];
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    sign = TIME_SIGN(minmax);
+	    for (dir = RISING; dir <= FALLING; dir++) {
+		idx = SLACK_INDEX(node, minmax, dir);
+		if (arrtime[idx] == -sign * SLACK_NONE) continue;
+		reqtime[idx] = slack_required(graph, cn, reqtime, graph->nodes[node],
+			dir, trans[idx], minmax);
+	    }
+	}
+    }
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	for (i = 0; i < lstate[minmax]->numlaunch; i++) {
+	    lptr = lstate[minmax]->launches + i;
+	    delay = -((lptr->source) ? lptr->source->delay : 0.0);
+	    slack = slack_required(graph, cn, reqtime, lptr->conn, lptr->dir,
+			lptr->trans, minmax);
+	    for (dir = RISING; dir <= FALLING; dir++)
+		if (lptr->dir & dir)
+		    slack_merge(arrtime, reqtime, SLACK_INDEX(lptr->conn->index,
+				minmax, dir), delay, slack, minmax);
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Find the required time and slack of every connection of the	*/
+/* design, for both analyses, and keep them in des->slacks.	*/
+/*								*/
+/* The arrival times are those of the levelized search (run	*/
+/* here if the design does not already have its results), from	*/
+/* register clocks and from module inputs.  As the clock skew	*/
+/* and setup or hold time at an endpoint apply only to paths	*/
+/* from a related clock, each is given its own backward pass	*/
+/* (see slack_required_times()), and the times giving the	*/
+/* worse slack are kept at each connection and edge direction.	*/
+/* Without a clock period, the worst setup path delay is used,	*/
+/* so that the critical path has zero slack.			*/
+/*--------------------------------------------------------------*/
+
+static void
+build_slack_map(design *des)
+{
+    slackmap	*smap = &des->slacks;
+    tgraph	*graph = des->graph;
+    levelstate	*lstate[2][2];
+    double	*arrtime[2], *reqtime[2], *trans, *pathdelay;
+    double	sign, slack, period, maxdelay;
+    char	sweep[2], minmax;
+    short	dir;
+    int		i, k, idx, numslots;
+
+    if (!des->clocks.valid) find_clock_latencies(des);
+
+    // Arrivals from register clocks (k = 0) and from module inputs
+    // (k = 1), kept from an earlier search if the design has them
+
+    for (k = 0; k < 2; k++) {
+	sweep[k] = 0;
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    lstate[k][minmax] = des->levels + 2 * k + ((minmax == MINIMUM_TIME) ? 1 : 0);
+	    if (!lstate[k][minmax]->valid) sweep[k] |= ANALYSIS(minmax);
+	}
+	if (sweep[k])
+	    levelized_sweep(graph, des->corner, &des->clocks,
+			(k) ? des->inputconnlist : des->clockconnlist, NULL,
+			lstate[k], sweep[k], (perendpoint > 1) ? perendpoint : 1);
+    }
+
+    free_slack_map(smap);
+    numslots = 4 * graph->numconns;
+    smap->numconns = graph->numconns;
+    smap->slack = (double *)malloc(2 * graph->numconns * sizeof(double));
+    trans = (double *)malloc(2 * numslots * sizeof(double));
+    pathdelay = (double *)malloc(2 * numslots * sizeof(double));
+    for (k = 0; k < 2; k++) {
+	arrtime[k] = (double *)malloc(numslots * sizeof(double));
+	reqtime[k] = (double *)malloc(numslots * sizeof(double));
+	for (i = 0; i < numslots; i++) {
+	    sign = TIME_SIGN((i >> 1) & 1);	// Analysis of SLACK_INDEX()
+	    arrtime[k][i] = -sign * SLACK_NONE;
+	    reqtime[k][i] = sign * SLACK_NONE;
+	    trans[k * numslots + i] = 0.0;
+	    pathdelay[k * numslots + i] = 0.0;
+	}
+    }
+
+    maxdelay = 0.0;
+    for (k = 0; k < 2; k++) {
+	period = slack_arrivals(graph, lstate[k], arrtime[k], trans + k * numslots,
+			pathdelay + k * numslots);
+	if (period > maxdelay) maxdelay = period;
+    }
+    period = (des->period > 0.0) ? des->period : maxdelay;
+
+    for (k = 0; k < 2; k++)
+	slack_required_times(graph, des->corner, lstate[k], period, arrtime[k],
+			trans + k * numslots, pathdelay + k * numslots, reqtime[k]);
+
+    // Keep the times of the worse slack, and the slack of each
+    // connection, the worse of the two edge directions
+
+    for (i = 0; i < graph->numconns; i++) {
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    smap->slack[2 * i + minmax] = SLACK_NONE;
+	    for (dir = RISING; dir <= FALLING; dir++) {
+		idx = SLACK_INDEX(i, minmax, dir);
+		slack_merge(arrtime[0], reqtime[0], idx, arrtime[1][idx],
+			reqtime[1][idx], minmax);
+		if (minmax == MAXIMUM_TIME)
+		    slack = reqtime[0][idx] - arrtime[0][idx];
+		else
+		    slack = arrtime[0][idx] - reqtime[0][idx];
+		if (slack < smap->slack[2 * i + minmax])
+		    smap->slack[2 * i + minmax] = slack;
+	    }
+	}
+    }
+    smap->arrival = arrtime[0];
+    smap->required = reqtime[0];
+    smap->period = period;
+    smap->valid = 1;
+
+    for (k = 0; k < 2; k++)
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++)
+	    if ((sweep[k] & ANALYSIS(minmax)) && !des->incremental)
+		free_level_state(lstate[k][minmax]);
+
+    free(arrtime[1]);
+    free(reqtime[1]);
+    free(trans);
+    free(pathdelay);
+}
+
+/*--------------------------------------------------------------*/
+/* Merge the slack of connection "testconn" from the slack map	*/
+/* "smap" into "slack" (indexed by analysis), keeping the	*/
+/* worse of each.						*/
+/*--------------------------------------------------------------*/
+
+static void
+merge_conn_slack(slackmap *smap, connptr testconn, double *slack)
+{
+    char minmax;
+
+    if ((testconn == NULL) || (testconn->index < 0) ||
+		(testconn->index >= smap->numconns))
+	return;
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++)
+	if (smap->slack[2 * testconn->index + minmax] < slack[minmax])
+	    slack[minmax] = smap->slack[2 * testconn->index + minmax];
+}
+
+/*--------------------------------------------------------------*/
+/* Find the slack of net "testnet" (if "testconn" is NULL or	*/
+/* drives the net) or of connection "testconn" from the slack	*/
+/* map, by analysis, in "slack".  The slack of a net is the	*/
+/* worst of its driver and receivers.				*/
+/*--------------------------------------------------------------*/
+
+static void
+find_map_slack(design *des, netptr testnet, connptr testconn, double *slack)
+{
+    int i;
+
+    slack[MINIMUM_TIME] = slack[MAXIMUM_TIME] = SLACK_NONE;
+    if ((testconn != NULL) && (testconn != testnet->driver)) {
+	merge_conn_slack(&des->slacks, testconn, slack);
+	return;
+    }
+    merge_conn_slack(&des->slacks, testnet->driver, slack);
+    for (i = 0; i < testnet->fanout; i++)
+	merge_conn_slack(&des->slacks, testnet->receivers[i], slack);
+}
+
+/*--------------------------------------------------------------*/
+/* Write one entry of the slack map file, for a net or for	*/
+/* pin "name" of instance "instname":  a line of the text form,	*/
+/* or (for the binary form) a record on pass 1 and the name on	*/
+/* pass 2, "offset" being that of the name.  Return the size	*/
+/* of the name in the binary form.				*/
+/*--------------------------------------------------------------*/
+
+static size_t
+write_slack_entry(FILE *out, int format, char pass, size_t offset,
+		char *instname, char *name, double *slack)
+{
+    vesta_slackmap_record record;
+
+    if (format == VESTA_SLACKMAP_TEXT)
+	fprintf(out, "%s %s%s%s %g %g\n", (instname) ? "pin" : "net",
+		(instname) ? instname : "", (instname) ? "/" : "", name,
+		slack[MAXIMUM_TIME], slack[MINIMUM_TIME]);
+    else if (pass == 1) {
+	record.name = (uint32_t)offset;
+	record.type = (instname) ? VESTA_SLACKMAP_PIN : VESTA_SLACKMAP_NET;
+	record.setup = (float)slack[MAXIMUM_TIME];
+	record.hold = (float)slack[MINIMUM_TIME];
+	fwrite(&record, sizeof(record), 1, out);
+    }
+    else if (pass == 2) {
+	if (instname) fprintf(out, "%s/", instname);
+	fwrite(name, strlen(name) + 1, 1, out);
+    }
+    return strlen(name) + 1 + ((instname) ? strlen(instname) + 1 : 0);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the slack map of design "des" to "out", in text or	*/
+/* binary form (see vesta.h):  the setup and hold slack of	*/
+/* each net, then of each instance pin.  The slack of an	*/
+/* output pin is that of its net.				*/
+/*--------------------------------------------------------------*/
+
+static void
+write_slack_map(FILE *out, design *des, int format)
+{
+    vesta_slackmap_header header;
+    netptr   testnet;
+    instptr  testinst;
+    connptr  testconn;
+    double   slack[2];
+    size_t   offset;
+    char     pass;
+    int	     numrecords, k;
+
+    if (format == VESTA_SLACKMAP_TEXT) {
+	fprintf(out, "# vesta slack map:  net or pin, setup slack, hold slack (ps)\n");
+	fprintf(out, "# period %g ps\n", des->slacks.period);
+    }
+
+    for (pass = (format == VESTA_SLACKMAP_TEXT) ? 1 : 0;
+		pass <= ((format == VESTA_SLACKMAP_TEXT) ? 1 : 2); pass++) {
+	offset = 0;
+	numrecords = 0;
+	for (testnet = des->netlist; testnet; testnet = testnet->next) {
+	    find_map_slack(des, testnet, NULL, slack);
+	    offset += write_slack_entry(out, format, pass, offset, NULL,
+			testnet->name, slack);
+	    numrecords++;
+	}
+	for (testinst = des->instlist; testinst; testinst = testinst->next) {
+	    for (k = 0; k < 2; k++) {
+		testconn = (k == 0) ? testinst->in_connects : testinst->out_connects;
+		for (; testconn; testconn = testconn->next) {
+		    find_map_slack(des, testconn->refnet, testconn, slack);
+		    offset += write_slack_entry(out, format, pass, offset,
+				testinst->name, testconn->refpin->name, slack);
+		    numrecords++;
+		}
+	    }
+	}
+
+	if (pass == 0) {
+	    memset(&header, 0, sizeof(header));
+	    memcpy(header.magic, VESTA_SLACKMAP_MAGIC, sizeof(header.magic));
+	    header.version = VESTA_SLACKMAP_VERSION;
+	    header.numrecords = (int32_t)numrecords;
+	    header.period = des->slacks.period;
+	    header.names = (int64_t)(sizeof(header) + numrecords *
+			sizeof(vesta_slackmap_record));
+	    fwrite(&header, sizeof(header), 1, out);
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Return 1 if the connection "testconn" is named by "name",	*/
+/* which may be an instance name, an instance/pin name, or the	*/
+/* name of a module input or output.				*/
+/*--------------------------------------------------------------*/
+
+static int
+match_connection(connptr testconn, char *name)
+{
+    int len;
+
+    if (testconn->refinst == NULL)
+	return (strcmp(testconn->refnet->name, name) == 0);
+
+    if (!strcmp(testconn->refinst->name, name)) return 1;
+    len = strlen(testconn->refinst->name);
+    if (strncmp(testconn->refinst->name, name, len)) return 0;
+    if (name[len] != '/') return 0;
+    return (testconn->refpin && !strcmp(testconn->refpin->name, name + len + 1));
+}
+
+/*--------------------------------------------------------------*/
+/* Server command "report_timing":  list the worst paths found	*/
+/* in the design, optionally only those starting or ending at	*/
+/* a given point.						*/
+/*								*/
+/*   report_timing [-max|-min] [-from <point>] [-to <point>]	*/
+/*		   [-n <count>] [-per_endpoint <count>]		*/
+/*--------------------------------------------------------------*/
+
+static void
+server_report_timing(FILE *out, design *des, char *args)
+{
+    pathset  *pset;
+    ddataptr *found, *worst, testddata;
+    btptr    testbt;
+    char     *token, *from, *to, minmax;
+    int	     count, pergroup, numfound, i, k;
+
+    minmax = MAXIMUM_TIME;
+    from = to = NULL;
+    count = numreport;
+    pergroup = perendpoint;
+    for (token = strtok(args, " \t"); token; token = strtok(NULL, " \t")) {
+	if (!strcmp(token, "-max"))
+	    minmax = MAXIMUM_TIME;
+	else if (!strcmp(token, "-min"))
+	    minmax = MINIMUM_TIME;
+	else if (!strcmp(token, "-from"))
+	    from = strtok(NULL, " \t");
+	else if (!strcmp(token, "-to"))
+	    to = strtok(NULL, " \t");
+	else if (!strcmp(token, "-n")) {
+	    token = strtok(NULL, " \t");
+	    if (token) sscanf(token, "%d", &count);
+	}
+	else if (!strcmp(token, "-per_endpoint")) {
+	    token = strtok(NULL, " \t");
+	    if (token) sscanf(token, "%d", &pergroup);
+	}
+	else {
+	    fprintf(out, "ERROR: Unknown option \"%s\"\n", token);
+	    return;
+	}
+    }
+
+    // Collect the matching paths from both register clocks and inputs
+
+    pset = find_design_paths(out, des, 0, minmax);
+    numfound = pset->numpaths;
+    pset = find_design_paths(out, des, 1, minmax);
+    numfound += pset->numpaths;
+    found = (ddataptr *)malloc((numfound + 1) * sizeof(ddataptr));
+
+    numfound = 0;
+    for (k = 0; k < 2; k++) {
+	pset = find_design_paths(out, des, k, minmax);
+	for (i = 0; i < pset->numpaths; i++) {
+	    testddata = pset->paths[i];
+	    if (to && !match_connection(testddata->backtrace->receiver, to))
+		continue;
+	    if (from) {
+		for (testbt = testddata->backtrace; testbt->next; testbt = testbt->next);
+		if (!match_connection(testbt->receiver, from)) continue;
+	    }
+	    found[numfound++] = testddata;
+	}
+    }
+
+    worst = (ddataptr *)malloc((numfound + 1) * sizeof(ddataptr));
+    count = select_worst_paths(found, numfound, count, pergroup,
+		des->graph->numnodes, minmax, worst);
+    for (i = 0; i < count; i++) {
+	testddata = worst[i];
+	print_path(out, testddata);
+	if (minmax == MINIMUM_TIME)
+	    fprintf(out, "   Slack = %g ps", testddata->delay);
+	else if (des->period > 0.0)
+	    fprintf(out, "   Slack = %g ps", des->period - testddata->delay);
+	fprintf(out, "\n");
+    }
+    free(worst);
+    free(found);
+    fprintf(out, "OK\n");
+}
+
+/*--------------------------------------------------------------*/
+/* Find the connection named "instance/pin", or NULL.		*/
+/*--------------------------------------------------------------*/
+
+static connptr
+find_instance_pin(hashtable *insts, char *name)
+{
+    instptr  testinst;
+    connptr  testconn;
+    char     *instname, *pinname;
+    int	     k;
+
+    instname = strdup(name);
+    pinname = strrchr(instname, '/');
+    testinst = NULL;
+    if (pinname != NULL) {
+	*pinname++ = '\0';
+	testinst = (instptr)hash_lookup(insts, instname, NULL);
+    }
+    testconn = NULL;
+    if (testinst != NULL) {
+	for (k = 0; (k < 2) && (testconn == NULL); k++) {
+	    testconn = (k == 0) ? testinst->in_connects : testinst->out_connects;
+	    for (; testconn; testconn = testconn->next)
+		if (!strcmp(testconn->refpin->name, pinname))
+		    break;
+	}
+    }
+    free(instname);
+    return testconn;
+}
+
+/*--------------------------------------------------------------*/
+/* Find cell "name" in the library (the first one, if the	*/
+/* library has more than one, as in verilogRead()).		*/
+/*--------------------------------------------------------------*/
+
+static cellptr
+find_cell(design *des, char *name)
+{
+    cellptr testcell;
+
+    for (testcell = des->cells; testcell; testcell = testcell->next)
+	if (!strcasecmp(testcell->name, name))
+	    return testcell;
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Index the nets and instances of the design by name, for the	*/
+/* lookups of the server commands and the C interface.  The	*/
+/* instance and net made by vesta_insert_buffer() are added to	*/
+/* the index there.						*/
+/*--------------------------------------------------------------*/
+
+static void
+index_design_names(design *des)
+{
+    netptr testnet;
+    instptr testinst;
+
+    if (des->indexed) return;
+    hash_init(&des->nets, 4096, 0);
+    for (testnet = des->netlist; testnet; testnet = testnet->next)
+	if (hash_lookup(&des->nets, testnet->name, NULL) == NULL)
+	    hash_insert(&des->nets, testnet->name, NULL, testnet);
+    hash_init(&des->insts, 4096, 0);
+    for (testinst = des->instlist; testinst; testinst = testinst->next)
+	hash_insert(&des->insts, testinst->name, NULL, testinst);
+    des->indexed = 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Record the message of a call that failed, for vesta_error()	*/
+/* or the server's error reply.  Always returns -1.		*/
+/*--------------------------------------------------------------*/
+
+static int
+design_error(design *des, char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(des->error, sizeof(des->error), fmt, args);
+    va_end(args);
+    return -1;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the stream for the progress messages of design "des"	*/
+/* (see vesta_set_log()), or NULL if they are not wanted.	*/
+/*--------------------------------------------------------------*/
+
+static FILE *
+design_log(design *des)
+{
+    if (des->logset) return des->log;
+    return (verbose > 0) ? stderr : NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the net or the instance pin ("instance/pin") named	*/
+/* "name", and return its net, or NULL if there is no such net	*/
+/* or pin.  "*pinconn" is set to the connection of a pin, or to	*/
+/* NULL for a net.						*/
+/*--------------------------------------------------------------*/
+
+static netptr
+find_net_or_pin(design *des, char *name, connptr *pinconn)
+{
+    netptr testnet;
+
+    *pinconn = NULL;
+    index_design_names(des);
+    testnet = (netptr)hash_lookup(&des->nets, name, NULL);
+    if (testnet == NULL) {
+	*pinconn = find_instance_pin(&des->insts, name);
+	if (*pinconn != NULL) testnet = (*pinconn)->refnet;
+    }
+    return testnet;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the worst maximum and minimum delay of the paths (one	*/
+/* per endpoint) that pass through connection "testconn", or	*/
+/* through any receiver of net "testnet" if "testconn" is	*/
+/* NULL (or is the driver of the net, as the paths through an	*/
+/* output pin are those through its net).  For each analysis, "found" is set if there is such a	*/
+/* path, and the worst delay is returned in "worst".  The	*/
+/* number of paths is reported to "out" as by			*/
+/* find_design_paths().						*/
+/*--------------------------------------------------------------*/
+
+static void
+find_worst_through(FILE *out, design *des, netptr testnet, connptr testconn,
+		double *worst, char *found)
+{
+    pathset  *pset;
+    ddataptr testddata;
+    btptr    testbt;
+    char     minmax;
+    int	     i, k;
+
+    if (testconn == testnet->driver) testconn = NULL;
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	found[minmax] = 0;
+	for (k = 0; k < ((minmax == MAXIMUM_TIME) ? 2 : 1); k++) {
+	    pset = find_design_paths(out, des, k, minmax);
+	    for (i = 0; i < pset->numpaths; i++) {
+		testddata = pset->paths[i];
+		for (testbt = testddata->backtrace; testbt; testbt = testbt->next)
+		    if ((testconn) ? (testbt->receiver == testconn) :
+				(testbt->receiver->refnet == testnet))
+			break;
+		if (testbt == NULL) continue;
+		if (!found[minmax] || TIME_WORSE(minmax, testddata->delay, worst[minmax]))
+		    worst[minmax] = testddata->delay;
+		found[minmax] = 1;
+	    }
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Server command "slack":  report the worst setup and hold	*/
+/* slack of the paths (one per endpoint) that pass through a	*/
+/* net or an instance pin.  Without a clock period, the worst	*/
+/* delay is reported in place of the setup slack.		*/
+/*								*/
+/*   slack <net> | <instance>/<pin>				*/
+/*--------------------------------------------------------------*/
+
+static void
+server_slack(FILE *out, design *des, char *name)
+{
+    netptr   testnet;
+    connptr  testconn;
+    double   worst[2];
+    char     found[2];
+
+    testnet = (name) ? find_net_or_pin(des, name, &testconn) : NULL;
+    if (testnet == NULL) {
+	fprintf(out, "ERROR: No such net or pin \"%s\"\n", (name) ? name : "");
+	return;
+    }
+    find_worst_through(out, des, testnet, testconn, worst, found);
+
+    fprintf(out, "%s %s:", (testconn) ? "Pin" : "Net", (testconn) ? name : testnet->name);
+    if (!found[MAXIMUM_TIME])
+	fprintf(out, "  no paths\n");
+    else {
+	if (des->period > 0.0)
+	    fprintf(out, "  setup slack %g ps", des->period - worst[MAXIMUM_TIME]);
+	else
+	    fprintf(out, "  maximum delay %g ps", worst[MAXIMUM_TIME]);
+	if (found[MINIMUM_TIME])
+	    fprintf(out, "  hold slack %g ps", worst[MINIMUM_TIME]);
+	fprintf(out, "\n");
+    }
+    fprintf(out, "OK\n");
+}
+
+/*--------------------------------------------------------------*/
+/* Update the timing after an ECO command and report the worst	*/
+/* setup and hold slack of the design.  As in report_corners(),	*/
+/* the hold slack is taken from the register-to-register paths	*/
+/* only, since the paths from the module inputs end at the	*/
+/* register clocks with a delay of zero.			*/
+/*--------------------------------------------------------------*/
+
+static void
+server_eco_report(FILE *out, design *des)
+{
+    pathset  *pset;
+    ddataptr testddata;
+    double   worst[2], delay;
+    char     found[2], minmax;
+    int	     numevals, k;
+
+    numevals = update_design_timing(des);
+    if (levelized)
+	fprintf(out, "Arrival times updated at %d nodes\n", numevals);
+
+    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	found[minmax] = 0;
+	for (k = 0; k < ((minmax == MAXIMUM_TIME) ? 2 : 1); k++) {
+	    pset = find_design_paths(out, des, k, minmax);
+	    if (select_worst_paths(pset->paths, pset->numpaths, 1, 0,
+			des->graph->numnodes, minmax, &testddata) == 0)
+		continue;
+	    delay = testddata->delay;
+	    if (!found[minmax] ||
+			((minmax == MAXIMUM_TIME) && (delay > worst[minmax])) ||
+			((minmax == MINIMUM_TIME) && (delay < worst[minmax])))
+		worst[minmax] = delay;
+	    found[minmax] = 1;
+	}
+    }
+
+    if (found[MAXIMUM_TIME]) {
+	if (des->period > 0.0)
+	    fprintf(out, "Worst setup slack %g ps", des->period - worst[MAXIMUM_TIME]);
+	else
+	    fprintf(out, "Maximum delay %g ps", worst[MAXIMUM_TIME]);
+	if (found[MINIMUM_TIME])
+	    fprintf(out, "  worst hold slack %g ps", worst[MINIMUM_TIME]);
+	fprintf(out, "\n");
+    }
+    fprintf(out, "OK\n");
+}
+
+/*--------------------------------------------------------------*/
+/* Server command "swap_cell":  change the cell of an instance	*/
+/*								*/
+/*   swap_cell <instance> <cell>				*/
+/*--------------------------------------------------------------*/
+
+static void
+server_swap_cell(FILE *out, design *des, char *args)
+{
+    char *instname, *cellname;
+
+    instname = strtok(args, " \t");
+    cellname = strtok(NULL, " \t");
+    if (cellname == NULL) {
+	fprintf(out, "ERROR: Usage:  swap_cell <instance> <cell>\n");
+	return;
+    }
+    if (vesta_swap_cell(des, instname, cellname) < 0) {
+	fprintf(out, "ERROR: %s\n", des->error);
+	return;
+    }
+    server_eco_report(out, des);
+}
+
+/*--------------------------------------------------------------*/
+/* Server command "reconnect":  move an instance pin to a net	*/
+/*								*/
+/*   reconnect <instance>/<pin> <net>				*/
+/*--------------------------------------------------------------*/
+
+static void
+server_reconnect(FILE *out, design *des, char *args)
+{
+    char *pinname, *netname;
+
+    pinname = strtok(args, " \t");
+    netname = strtok(NULL, " \t");
+    if (netname == NULL) {
+	fprintf(out, "ERROR: Usage:  reconnect <instance>/<pin> <net>\n");
+	return;
+    }
+    if (vesta_reconnect(des, pinname, netname) < 0) {
+	fprintf(out, "ERROR: %s\n", des->error);
+	return;
+    }
+    server_eco_report(out, des);
+}
+
+/*--------------------------------------------------------------*/
+/* Server command "insert_buffer":  buffer some or all of the	*/
+/* receivers of a net.						*/
+/*								*/
+/*   insert_buffer <net> <cell> <instance> <newnet>		*/
+/*		   [<instance>/<pin> ...]			*/
+/*--------------------------------------------------------------*/
+
+static void
+server_insert_buffer(FILE *out, design *des, char *args)
+{
+    char    *netname, *cellname, *instname, *newname;
+    char    **sinks;
+    int	    numsinks, maxsinks, result;
+
+    netname = strtok(args, " \t");
+    cellname = strtok(NULL, " \t");
+    instname = strtok(NULL, " \t");
+    newname = strtok(NULL, " \t");
+    if (newname == NULL) {
+	fprintf(out, "ERROR: Usage:  insert_buffer <net> <cell> <instance> <newnet>"
+		" [<instance>/<pin> ...]\n");
+	return;
+    }
+
+    maxsinks = 16;
+    sinks = (char **)malloc(maxsinks * sizeof(char *));
+    numsinks = 0;
+    while ((sinks[numsinks] = strtok(NULL, " \t")) != NULL) {
+	if (++numsinks == maxsinks) {
+	    maxsinks *= 2;
+	    sinks = (char **)realloc(sinks, maxsinks * sizeof(char *));
+	}
+    }
+
+    result = vesta_insert_buffer(des, netname, cellname, instname, newname,
+		sinks, numsinks);
+    free(sinks);
+    if (result < 0) {
+	fprintf(out, "ERROR: %s\n", des->error);
+	return;
+    }
+    server_eco_report(out, des);
+}
+
+/*--------------------------------------------------------------*/
+/* Server command "write_slack_map":  write the setup and hold	*/
+/* slack of every net and instance pin to a file (see		*/
+/* vesta_write_slack_map()), in binary form with "-binary".	*/
+/*								*/
+/*   write_slack_map <file> [-binary]				*/
+/*--------------------------------------------------------------*/
+
+static void
+server_write_slack_map(FILE *out, design *des, char *args)
+{
+    char *filename, *option;
+    int format;
+
+    filename = strtok(args, " \t");
+    option = strtok(NULL, " \t");
+    if ((filename == NULL) || ((option != NULL) && strcmp(option, "-binary"))) {
+	fprintf(out, "ERROR: Usage:  write_slack_map <file> [-binary]\n");
+	return;
+    }
+    format = (option) ? VESTA_SLACKMAP_BINARY : VESTA_SLACKMAP_TEXT;
+    if (vesta_write_slack_map(des, filename, format) < 0) {
+	fprintf(out, "ERROR: %s\n", des->error);
+	return;
+    }
+    fprintf(out, "OK\n");
+}
+
+/*--------------------------------------------------------------*/
+/* Answer commands read from "in", one per line, writing the	*/
+/* results to "out".  Each reply ends with a line "OK" or a	*/
+/* line starting with "ERROR:".  Return 1 if the command	*/
+/* "shutdown" was given, or 0 at end of input, on "quit", or	*/
+/* if a reply cannot be written (the client has gone away).	*/
+/*--------------------------------------------------------------*/
+
+static int
+serve_design(FILE *in, FILE *out, design *des)
+{
+    char   line[LIB_LINE_MAX];
+    char   *command, *args;
+    double value;
+    int	   ival;
+
+    while (fgets(line, LIB_LINE_MAX, in) != NULL) {
+	line[strcspn(line, "\r\n")] = '\0';
+	command = strtok(line, " \t");
+	if (command == NULL) continue;
+	args = strtok(NULL, "");
+	if (args == NULL) args = "";
+
+	if (!strcmp(command, "report_timing"))
+	    server_report_timing(out, des, args);
+	else if (!strcmp(command, "slack"))
+	    server_slack(out, des, strtok(args, " \t"));
+	else if (!strcmp(command, "set_load")) {
+	    if (sscanf(args, "%lg", &value) != 1)
+		fprintf(out, "ERROR: Usage:  set_load <fF>\n");
+	    else {
+		vesta_set_load(des, value);
+		fprintf(out, "OK\n");
+	    }
+	}
+	else if (!strcmp(command, "set_period")) {
+	    if (sscanf(args, "%lg", &value) != 1)
+		fprintf(out, "ERROR: Usage:  set_period <ps>\n");
+	    else {
+		vesta_set_period(des, value);
+		fprintf(out, "OK\n");
+	    }
+	}
+	else if (!strcmp(command, "swap_cell"))
+	    server_swap_cell(out, des, args);
+	else if (!strcmp(command, "reconnect"))
+	    server_reconnect(out, des, args);
+	else if (!strcmp(command, "insert_buffer"))
+	    server_insert_buffer(out, des, args);
+	else if (!strcmp(command, "write_slack_map"))
+	    server_write_slack_map(out, des, args);
+	else if (!strcmp(command, "verify_timing")) {
+	    ival = verify_design_timing(des);
+	    if (ival == 0)
+		fprintf(out, "OK\n");
+	    else
+		fprintf(out, "ERROR: %d values differ from a full analysis\n", ival);
+	}
+	else if (!strcmp(command, "retime")) {
+	    // Full analysis, discarding all incremental results
+	    computeLoads(des->netlist, des->instlist, des->outload);
+	    invalidate_design_arrivals(des);
+	    report_design_timing(out, des);
+	    fprintf(out, "OK\n");
+	}
+	else if (!strcmp(command, "help")) {
+	    fprintf(out, "report_timing [-max|-min] [-from <point>] [-to <point>] "
+			"[-n <count>] [-per_endpoint <count>]\n");
+	    fprintf(out, "slack <net> | <instance>/<pin>\n");
+	    fprintf(out, "set_load <fF>\n");
+	    fprintf(out, "set_period <ps>\n");
+	    fprintf(out, "swap_cell <instance> <cell>\n");
+	    fprintf(out, "reconnect <instance>/<pin> <net>\n");
+	    fprintf(out, "insert_buffer <net> <cell> <instance> <newnet> "
+			"[<instance>/<pin> ...]\n");
+	    fprintf(out, "write_slack_map <file> [-binary]\n");
+	    fprintf(out, "verify_timing\n");
+	    fprintf(out, "retime\n");
+	    fprintf(out, "quit\n");
+	    fprintf(out, "shutdown\n");
+	    fprintf(out, "OK\n");
+	}
+	else if (!strcmp(command, "quit") || !strcmp(command, "exit")) {
+	    fprintf(out, "OK\n");
+	    fflush(out);
+	    return 0;
+	}
+	else if (!strcmp(command, "shutdown")) {
+	    fprintf(out, "OK\n");
+	    fflush(out);
+	    return 1;
+	}
+	else
+	    fprintf(out, "ERROR: Unknown command \"%s\"\n", command);
+	if ((fflush(out) != 0) || ferror(out)) break;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Run the timing server.  If "sockname" is NULL, commands are	*/
+/* read from stdin.  Otherwise, listen on the UNIX socket	*/
+/* "sockname" and serve one client connection at a time until	*/
+/* a client gives the "shutdown" command.  A socket left at	*/
+/* "sockname" by an earlier server is replaced, but any other	*/
+/* kind of file there is an error, and is left alone.		*/
+/*--------------------------------------------------------------*/
+
+static int
+run_server(design *des, char *sockname)
+{
+    struct sockaddr_un addr;
+    struct stat sbuf;
+    FILE *in, *out;
+    int sock, conn, done;
+
+    index_design_names(des);
+
+    // Keep the levelized search results for incremental updates
+    des->incremental = 1;
+
+    if (sockname == NULL) {
+	fprintf(stdout, "Ready.\n");
+	fflush(stdout);
+	serve_design(stdin, stdout, des);
+	return 0;
+    }
+
+    if (strlen(sockname) >= sizeof(addr.sun_path)) {
+	fprintf(stderr, "Socket name \"%s\" is too long\n", sockname);
+	return 1;
+    }
+    sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0) {
+	fprintf(stderr, "Cannot create socket:  %s\n", strerror(errno));
+	return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, sockname);
+    if (lstat(sockname, &sbuf) == 0) {
+	if (!S_ISSOCK(sbuf.st_mode)) {
+	    fprintf(stderr, "Cannot listen on %s:  file exists and is not "
+			"a socket\n", sockname);
+	    close(sock);
+	    return 1;
+	}
+	unlink(sockname);
+    }
+    if ((bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+		(listen(sock, 4) < 0)) {
+	fprintf(stderr, "Cannot listen on socket %s:  %s\n", sockname,
+			strerror(errno));
+	close(sock);
+	return 1;
+    }
+    fprintf(stdout, "Listening on %s\n", sockname);
+    fflush(stdout);
+
+    done = 0;
+    while (!done) {
+	conn = accept(sock, NULL, NULL);
+	if (conn < 0) {
+	    if (errno == EINTR) continue;
+	    fprintf(stderr, "Error accepting connection:  %s\n", strerror(errno));
+	    break;
+	}
+	in = fdopen(conn, "r");
+	out = fdopen(dup(conn), "w");
+	done = serve_design(in, out, des);
+	fclose(in);
+	fclose(out);
+    }
+    close(sock);
+    unlink(sockname);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Table lookup microbenchmark (option --bench-tables).		*/
+/*--------------------------------------------------------------*/
+
+// Reference lookup for the benchmark:  the bounding index entries are
+// found by a linear scan, and each table is evaluated separately.
+
+static double vector_scan_value(lutableptr tableptr, double *vector, double trans)
+{
+    int i;
+    double tfrac, vlow, vhigh;
+
+    if (trans < tableptr->idx1.times[0])
+	i = 1;
+    else if (trans >= tableptr->idx1.times[tableptr->size1 - 1])
+	i = tableptr->size1 - 1;
+    else {
+	for (i = 0; i < tableptr->size1; i++)
+	    if (tableptr->idx1.times[i] > trans)
+		break;
+    }
+    tfrac = (trans - tableptr->idx1.times[i - 1]) /
+		(tableptr->idx1.times[i] - tableptr->idx1.times[i - 1]);
+    vlow = *(vector + (i - 1));
+    vhigh = *(vector + i);
+    return vlow + (vhigh - vlow) * tfrac;
+}
+
+// Return 1 if "table" is a delay or transition table (not a setup or
+// hold constraint table) that can be evaluated by vector_get_value().
+
+static int
+bench_delay_table(lutableptr table)
+{
+    if (table == NULL) return 0;
+    if (table->size1 < 2) return 0;
+    if ((table->var1 == RELATED_TIME) || (table->var1 == CONSTRAINED_TIME)) return 0;
+    if ((table->var2 == RELATED_TIME) || (table->var2 == CONSTRAINED_TIME)) return 0;
+    return 1;
+}
+
+static double
+bench_seconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.0E-9 * (double)ts.tv_nsec;
+}
+
+#define BENCH_POINTS	16	// Transition times evaluated per table pair
+
+/*--------------------------------------------------------------*/
+/* Collapse the rise and fall delay and transition tables of	*/
+/* every cell pin in the library at a load in the middle of	*/
+/* the table range, then evaluate each pair "count" times at	*/
+/* BENCH_POINTS transition times spread across (and beyond)	*/
+/* the table range, first with the reference lookup and then	*/
+/* with vector_get_pair().  Report the time per lookup and any	*/
+/* result that is not bit-identical to the reference.		*/
+/*--------------------------------------------------------------*/
+
+static void
+bench_table_lookups(cell *cells, int count)
+{
+    cell     *testcell;
+    pin	     *testpin;
+    lutableptr *rtables, *ftables, tables[4];
+    double   **rvectors, **fvectors, *points;
+    double   values[2], rvalue, fvalue, load, lo, hi, start, scantime, pairtime;
+    volatile double sum;
+    int	     numpairs, maxpairs, mismatches, i, k, p, rep;
+    unsigned int seed;
+    long     numlookups;
+
+    maxpairs = 64;
+    numpairs = 0;
+    rtables = (lutableptr *)malloc(maxpairs * sizeof(lutableptr));
+    ftables = (lutableptr *)malloc(maxpairs * sizeof(lutableptr));
+    rvectors = (double **)malloc(maxpairs * sizeof(double *));
+    fvectors = (double **)malloc(maxpairs * sizeof(double *));
+
+    for (testcell = cells; testcell; testcell = testcell->next) {
+	for (testpin = testcell->pins; testpin; testpin = testpin->next) {
+	    tables[0] = testpin->propdelr;
+	    tables[1] = testpin->propdelf;
+	    tables[2] = testpin->transr;
+	    tables[3] = testpin->transf;
+	    for (k = 0; k < 4; k += 2) {
+		if (!bench_delay_table(tables[k]) || !bench_delay_table(tables[k + 1]))
+		    continue;
+		if (numpairs == maxpairs) {
+		    maxpairs *= 2;
+		    rtables = (lutableptr *)realloc(rtables, maxpairs * sizeof(lutableptr));
+		    ftables = (lutableptr *)realloc(ftables, maxpairs * sizeof(lutableptr));
+		    rvectors = (double **)realloc(rvectors, maxpairs * sizeof(double *));
+		    fvectors = (double **)realloc(fvectors, maxpairs * sizeof(double *));
+		}
+		for (i = 0; i < 2; i++) {
+		    load = (tables[k + i]->size2 > 1) ?
+			tables[k + i]->idx2.caps[tables[k + i]->size2 / 2] : 0.0;
+		    if (i == 0) {
+			rtables[numpairs] = tables[k];
+			rvectors[numpairs] = (double *)malloc(tables[k]->size1 *
+				sizeof(double));
+			table_collapse(tables[k], load, rvectors[numpairs]);
+		    }
+		    else {
+			ftables[numpairs] = tables[k + 1];
+			fvectors[numpairs] = (double *)malloc(tables[k + 1]->size1 *
+				sizeof(double));
+			table_collapse(tables[k + 1], load, fvectors[numpairs]);
+		    }
+		}
+		numpairs++;
+	    }
+	}
+    }
+    if (numpairs == 0) {
+	fprintf(stderr, "No delay tables found in the library.\n");
+	return;
+    }
+
+    // Transition times from half the lowest index to 1.5 times the
+    // highest, for each table pair
+
+    points = (double *)malloc(numpairs * BENCH_POINTS * sizeof(double));
+    seed = 1;
+    for (p = 0; p < numpairs; p++) {
+	lo = 0.5 * rtables[p]->idx1.times[0];
+	hi = 1.5 * rtables[p]->idx1.times[rtables[p]->size1 - 1];
+	for (i = 0; i < BENCH_POINTS; i++)
+	    points[p * BENCH_POINTS + i] = lo + (hi - lo) * i / (BENCH_POINTS - 1);
+
+	// Shuffle the points (with a fixed seed, so that runs are
+	// comparable), as successive lookups in a path search do not
+	// go through a table in order.
+
+	for (i = BENCH_POINTS - 1; i > 0; i--) {
+	    seed = seed * 1103515245 + 12345;
+	    k = (seed >> 16) % (i + 1);
+	    lo = points[p * BENCH_POINTS + i];
+	    points[p * BENCH_POINTS + i] = points[p * BENCH_POINTS + k];
+	    points[p * BENCH_POINTS + k] = lo;
+	}
+    }
+
+    // Check that the results are identical
+
+    mismatches = 0;
+    for (p = 0; p < numpairs; p++) {
+	for (i = 0; i < BENCH_POINTS; i++) {
+	    rvalue = vector_scan_value(rtables[p], rvectors[p], points[p * BENCH_POINTS + i]);
+	    fvalue = vector_scan_value(ftables[p], fvectors[p], points[p * BENCH_POINTS + i]);
+	    vector_get_pair(rtables[p], rvectors[p], ftables[p], fvectors[p],
+			points[p * BENCH_POINTS + i], values);
+	    if (memcmp(&rvalue, values, sizeof(double))) mismatches++;
+	    if (memcmp(&fvalue, values + 1, sizeof(double))) mismatches++;
+	}
+    }
+
+    sum = 0.0;
+    start = bench_seconds();
+    for (rep = 0; rep < count; rep++)
+	for (p = 0; p < numpairs; p++)
+	    for (i = 0; i < BENCH_POINTS; i++) {
+		sum += vector_scan_value(rtables[p], rvectors[p],
+			points[p * BENCH_POINTS + i]);
+		sum += vector_scan_value(ftables[p], fvectors[p],
+			points[p * BENCH_POINTS + i]);
+	    }
+    scantime = bench_seconds() - start;
+
+    start = bench_seconds();
+    for (rep = 0; rep < count; rep++)
+	for (p = 0; p < numpairs; p++)
+	    for (i = 0; i < BENCH_POINTS; i++) {
+		vector_get_pair(rtables[p], rvectors[p], ftables[p], fvectors[p],
+			points[p * BENCH_POINTS + i], values);
+		sum += values[0] + values[1];
+	    }
+    pairtime = bench_seconds() - start;
+
+    numlookups = 2L * count * numpairs * BENCH_POINTS;
+    fprintf(stdout, "Table lookups:  %d rise/fall table pairs, %ld lookups each method\n",
+		numpairs, numlookups);
+    fprintf(stdout, "   Linear scan, one table per call:  %g ns per lookup\n",
+		1.0E9 * scantime / numlookups);
+    fprintf(stdout, "   Bracketed, rise and fall per call:  %g ns per lookup\n",
+		1.0E9 * pairtime / numlookups);
+    if (pairtime > 0.0)
+	fprintf(stdout, "   Speedup:  %.2fx\n", scantime / pairtime);
+    fprintf(stdout, "   Results differing from reference:  %d\n", mismatches);
+
+    for (p = 0; p < numpairs; p++) {
+	free(rvectors[p]);
+	free(fvectors[p]);
+    }
+    free(rtables);
+    free(ftables);
+    free(rvectors);
+    free(fvectors);
+    free(points);
+}
+
+
+/*--------------------------------------------------------------*/
+/* C interface (see vesta.h)					*/
+/*--------------------------------------------------------------*/
+
+/*--------------------------------------------------------------*/
+/* Fill "opts" with the default options:  the path search with	*/
+/* delay pruning on one thread, reporting 20 paths.		*/
+/*--------------------------------------------------------------*/
+
+void
+vesta_default_options(vestaopts *opts)
+{
+    opts->verbose = 0;
+    opts->pruning = VESTA_PRUNE_DELAY;
+    opts->levelized = 0;
+    opts->threads = 1;
+    opts->paths = 20;
+    opts->perendpoint = 0;
+    opts->profile = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Initialize the library, and set the options "opts" (or the	*/
+/* defaults, if NULL).  This must be called before any other	*/
+/* function, and may be called again to change the options.	*/
+/*--------------------------------------------------------------*/
+
+void
+vesta_init(vestaopts *opts)
+{
+    static char initialized = 0;
+    vestaopts defaults;
+
+    if (!initialized) {
+	memset(&prof, 0, sizeof(profile));
+	prof.wallstart = -1.0;
+	pthread_mutex_init(&prof.lock, NULL);
+	vecpool_init();
+	hash_init(&loopbreaks, 16, 0);
+	initialized = 1;
+    }
+
+    if (opts == NULL) {
+	vesta_default_options(&defaults);
+	opts = &defaults;
+    }
+    verbose = (unsigned char)opts->verbose;
+    pruning = (unsigned char)opts->pruning;
+    levelized = (opts->levelized) ? 1 : 0;
+    numthreads = (opts->threads < 1) ? 1 : opts->threads;
+    numreport = (opts->paths < 1) ? 1 : opts->paths;
+    perendpoint = (opts->perendpoint < 0) ? 0 : opts->perendpoint;
+    prof.enabled = (opts->profile) ? 1 : 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Read the input pins at which combinational loops are broken	*/
+/* (see read_loop_breaks()).  They apply to the netlists read	*/
+/* afterwards.  Return the number of pins read, or -1 if the	*/
+/* file cannot be read.						*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_read_loop_breaks(char *filename)
+{
+    return read_loop_breaks(filename);
+}
+
+/*--------------------------------------------------------------*/
+/* If profiling is enabled (see vestaopts), print the profile	*/
+/* of each phase to "out" and write it to the file "jsonname"	*/
+/* in JSON format.  Either may be NULL.				*/
+/*--------------------------------------------------------------*/
+
+void
+vesta_profile_write(FILE *out, char *jsonname)
+{
+    if (!prof.enabled) return;
+    if (out != NULL) profile_report(out);
+    if (jsonname != NULL) profile_write_json(jsonname);
+}
+
+/*--------------------------------------------------------------*/
+/* Create an empty design, with clock period "period" (0 if	*/
+/* none) and load "outload" on each module output.  A library	*/
+/* and then a netlist are read into it with			*/
+/* vesta_read_library() and vesta_read_netlist().		*/
+/*--------------------------------------------------------------*/
+
+vesta_design *
+vesta_create(double period, double outload)
+{
+    design *des;
+    int i;
+
+    // All lists, path sets and search results start out empty
+
+    des = (design *)calloc(1, sizeof(design));
+    des->period = period;
+    des->outload = outload;
+    for (i = 0; i < 4; i++)
+	arena_init(&des->paths[i].pool);
+    return des;
+}
+
+/*--------------------------------------------------------------*/
+/* Send the progress messages of design "des" (lines read, and	*/
+/* combinational loops broken) to "log", or discard them if	*/
+/* "log" is NULL.  By default they go to stderr when the	*/
+/* verbose option is set, and are discarded otherwise.		*/
+/*--------------------------------------------------------------*/
+
+void
+vesta_set_log(vesta_design *des, FILE *log)
+{
+    des->log = log;
+    des->logset = 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Read liberty file "libname" into design "des".  If		*/
+/* "cachename" is not NULL, the library is loaded from that	*/
+/* binary cache file if it was made from the same liberty	*/
+/* file, or else the cache file is written.  The library is	*/
+/* the first process corner of the design.  Return 0 on		*/
+/* success, or -1 on error.					*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_read_library(vesta_design *des, char *libname, char *cachename)
+{
+    tokenstream *flib;
+    unsigned long srchash = 0;
+    FILE *log = design_log(des);
+    char cached, error;
+    int closed;
+
+    if (des->cells != NULL)
+	return design_error(des, "A library has already been read");
+    flib = tokenstream_open(libname);
+    if (flib == NULL)
+	return design_error(des, "Cannot open %s for reading", libname);
+
+    /*------------------------------------------------------------------*/
+    /* Read the liberty format file.  This is not a rigorous parser!	*/
+    /*------------------------------------------------------------------*/
+
+    profile_phase("liberty read");
+    cached = 0;
+    if (cachename != NULL) {
+	srchash = libcache_source_hash(libname);
+	if (libcache_read(cachename, srchash, &des->tables, &des->cells) == 0) {
+	    if (log != NULL)
+		fprintf(log, "Lib Read:  Loaded from cache %s.\n", cachename);
+	    cached = 1;
+	}
+    }
+    if (!cached) {
+	if (libertyRead(flib, &des->tables, &des->cells, log) < 0) {
+	    error = flib->error;
+	    tokenstream_close(flib);
+	    if (error)
+		return design_error(des, "Compressed file %s is corrupt or "
+			"truncated", libname);
+	    return design_error(des, "Cannot read liberty file %s", libname);
+	}
+	if (log != NULL) {
+	    fflush(log);
+	    fprintf(log, "Lib Read:  Processed %d lines.\n", flib->line);
+	}
+	if (cachename != NULL)
+	    libcache_write(cachename, srchash, des->tables, des->cells);
+    }
+    share_table_indexes(des->cells);
+    closed = tokenstream_close(flib);
+
+    des->corners = (corner **)malloc(sizeof(corner *));
+    des->libnames = (char **)malloc(sizeof(char *));
+    des->corners[0] = NULL;
+    des->libnames[0] = strdup(libname);
+    des->numcorners = 1;
+    if (closed < 0)
+	return design_error(des, "Compressed file %s is corrupt or truncated",
+		libname);
+
+    /*--------------------------------------------------*/
+    /* Debug:  Print summary of liberty database	*/
+    /*--------------------------------------------------*/
+
+    if (verbose > 2) {
+
+	lutable *newtable;
+	cell *newcell;
+	pin *newpin;
+
+	for (newtable = des->tables; newtable; newtable = newtable->next) {
+	    fprintf(stdout, "Table: %s\n", newtable->name);
+	}
+
+	for (newcell = des->cells; newcell; newcell = newcell->next) {
+	    fprintf(stdout, "Cell: %s\n", newcell->name);
+	    fprintf(stdout, "   Function: %s\n", newcell->function);
+	    for (newpin = newcell->pins; newpin; newpin = newpin->next) {
+		if (newpin->type == INPUT)
+		    fprintf(stdout, "   Pin: %s  cap=%g\n", newpin->name, newpin->capr);
+	    }
+	    fprintf(stdout, "\n");
+	}
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Read verilog netlist "filename" into design "des", with the	*/
+/* library read by vesta_read_library(), and build its timing	*/
+/* graph.  Return 0 on success, or -1 on error.			*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_read_netlist(vesta_design *des, char *filename)
+{
+    tokenstream	*fsrc;
+    connlistptr newinputconn;
+    connptr	testconn;
+    FILE	*log = design_log(des);
+    int		numterms;
+
+    if (des->cells == NULL)
+	return design_error(des, "No library has been read");
+    if (des->graph != NULL)
+	return design_error(des, "A netlist has already been read");
+    fsrc = tokenstream_open(filename);
+    if (fsrc == NULL)
+	return design_error(des, "Cannot open %s for reading", filename);
+
+    /*------------------------------------------------------------------*/
+    /* Read verilog netlist.  This is also not a rigorous parser!	*/
+    /*------------------------------------------------------------------*/
+
+    profile_phase("verilog read");
+    if (verilogRead(fsrc, des->cells, &des->netlist, &des->instlist,
+		&des->inputlist, &des->outputlist, log) < 0) {
+	tokenstream_close(fsrc);
+	return design_error(des, "Compressed file %s is corrupt or truncated",
+		filename);
+    }
+    if (log != NULL) {
+	fflush(log);
+	fprintf(log, "Verilog netlist read:  Processed %d lines.\n", fsrc->line);
+    }
+    if (tokenstream_close(fsrc) < 0)
+	return design_error(des, "Compressed file %s is corrupt or truncated",
+		filename);
+
+    /*--------------------------------------------------*/
+    /* Debug:  Print summary of verilog source		*/
+    /*--------------------------------------------------*/
+
+    if (verbose > 1) {
+	connect *testoutput;
+	connect *testinput;
+	net *testnet;
+	instance *testinst;
+
+	for (testinput = des->inputlist; testinput; testinput = testinput->next) {
+	    if (testinput->refnet)
+		fprintf(stdout, "   Input: %s\n", testinput->refnet->name);
+	}
+	for (testoutput = des->outputlist; testoutput; testoutput = testoutput->next) {
+	    if (testoutput->refnet)
+		fprintf(stdout, "   Output: %s\n", testoutput->refnet->name);
+	}
+	for (testnet = des->netlist; testnet; testnet = testnet->next) {
+	    fprintf(stdout, "   Net: %s\n", testnet->name);
+	}
+	for (testinst = des->instlist; testinst; testinst = testinst->next) {
+	    fprintf(stdout, "   Gate: %s\n", testinst->name);
+	}
+    }
+
+    /*--------------------------------------------------*/
+    /* Generate internal links representing the network	*/
+    /*--------------------------------------------------*/
+
+    profile_phase("link");
+    createLinks(des->netlist, des->instlist, des->inputlist, des->outputlist);
+
+    /* Generate a connection list from inputlist */
+
+    for (testconn = des->inputlist; testconn; testconn = testconn->next) {
+	newinputconn = (connlistptr)malloc(sizeof(connlist));
+	newinputconn->connection = testconn;
+	newinputconn->next = des->inputconnlist;
+	des->inputconnlist = newinputconn;
+    }
+
+    /*--------------------------------------------------*/
+    /* Calculate total load on each net			*/
+    /* To do:  Add wire models or computed wire delays	*/
+    /*--------------------------------------------------*/
+
+    profile_phase("compute loads");
+    computeLoads(des->netlist, des->instlist, des->outload);
+
+    /*--------------------------------------------------*/
+    /* Assign net types, mainly to identify clocks	*/
+    /* Return a list of clock nets			*/
+    /*--------------------------------------------------*/
+
+    profile_phase("net types");
+    numterms = assign_net_types(des->netlist, &des->clockconnlist);
+
+    if (verbose > 1) 
+	fprintf(stdout, "Number of terminals to check: %d\n", numterms);
+
+    /*--------------------------------------------------*/
+    /* Build the levelized timing graph			*/
+    /*--------------------------------------------------*/
+
+    profile_phase("timing graph");
+    des->graph = build_timing_graph(des->netlist, des->inputconnlist);
+    check_loop_breaks(des->graph);
+    if (log != NULL) report_graph_loops(log, des->graph);
+    if (levelized && (verbose > 0))
+	fprintf(stdout, "Levelized timing graph:  %d nodes, %d loop arcs broken\n",
+		des->graph->numnodes, des->graph->numloops);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Add the process corner of liberty file "libname" to design	*/
+/* "des", after its netlist has been read.  Each corner is	*/
+/* timed by vesta_report_timing().  A design with more than	*/
+/* one corner cannot be changed.  Return 0 on success, or -1	*/
+/* if the library cannot be read or does not have the cells	*/
+/* of the netlist.						*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_add_corner(vesta_design *des, char *libname)
+{
+    tokenstream *flib;
+    lutable *tables;
+    cell    *cells;
+    corner  *cn;
+    char    *name;
+    FILE    *log = design_log(des);
+    char    error;
+
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+    flib = tokenstream_open(libname);
+    if (flib == NULL)
+	return design_error(des, "Cannot open %s for reading", libname);
+
+    // The setup of all corners is profiled as one phase
+
+    if (des->numcorners == 1) profile_phase("corner setup");
+
+    tables = NULL;
+    cells = NULL;
+    if (libertyRead(flib, &tables, &cells, log) < 0) {
+	error = flib->error;
+	tokenstream_close(flib);
+	if (error)
+	    return design_error(des, "Compressed file %s is corrupt or truncated",
+			libname);
+	return design_error(des, "Cannot read liberty file %s", libname);
+    }
+    if (log != NULL) {
+	fflush(log);
+	fprintf(log, "Lib Read:  Processed %d lines.\n", flib->line);
+    }
+    if (tokenstream_close(flib) < 0) {
+	free_library(tables, cells);
+	return design_error(des, "Compressed file %s is corrupt or truncated",
+		libname);
+    }
+
+    name = strdup(libname);
+    cn = create_corner(name, tables, cells, des->graph, des->instlist, des->outload);
+    if (cn == NULL) {
+	free(name);
+	free_library(tables, cells);
+	return design_error(des, "Cannot time process corner %s", libname);
+    }
+    share_table_indexes(cells);
+
+    des->corners = (corner **)realloc(des->corners,
+		(des->numcorners + 1) * sizeof(corner *));
+    des->libnames = (char **)realloc(des->libnames,
+		(des->numcorners + 1) * sizeof(char *));
+    des->corners[des->numcorners] = cn;
+    des->libnames[des->numcorners] = name;
+    des->numcorners++;
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the message of the last call on design "des" that	*/
+/* failed.							*/
+/*--------------------------------------------------------------*/
+
+char *
+vesta_error(vesta_design *des)
+{
+    return des->error;
+}
+
+/*--------------------------------------------------------------*/
+/* Free design "des" and its timing results.  The library and	*/
+/* netlist records are kept until the program exits, as the	*/
+/* shared table vectors (see vecpool) refer to the library	*/
+/* pins, and the netlist records are allocated in bulk.		*/
+/*--------------------------------------------------------------*/
+
+void
+vesta_free(vesta_design *des)
+{
+    connlistptr testlist;
+    int c;
+
+    invalidate_design_arrivals(des);
+    free_clock_tree(&des->clocks);
+    free_slack_map(&des->slacks);
+    if (des->graph != NULL) free_timing_graph(des->graph);
+
+    while (des->clockconnlist != NULL) {
+	testlist = des->clockconnlist;
+	des->clockconnlist = testlist->next;
+	free(testlist);
+    }
+    while (des->inputconnlist != NULL) {
+	testlist = des->inputconnlist;
+	des->inputconnlist = testlist->next;
+	free(testlist);
+    }
+
+    for (c = 0; c < des->numcorners; c++) {
+	if (des->corners[c] != NULL) {
+	    free(des->corners[c]->conns);
+	    free(des->corners[c]);
+	}
+	free(des->libnames[c]);
+    }
+    if (des->corners != NULL) free(des->corners);
+    if (des->libnames != NULL) free(des->libnames);
+
+    if (des->indexed) {
+	hash_free(&des->nets);
+	hash_free(&des->insts);
+    }
+    if (des->changed != NULL) free(des->changed);
+    free(des);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the full timing report of design "des" to "out":  the	*/
+/* worst maximum and minimum delay paths from register clocks	*/
+/* and from module inputs, for each process corner, with a	*/
+/* summary of the corners if there is more than one.  The	*/
+/* paths are discarded afterward.  Return 0 on success, or -1	*/
+/* if no netlist has been read.					*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_report_timing(vesta_design *des, FILE *out)
+{
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+
+    profile_phase("path search");
+    if (des->numcorners > 1)
+	report_corners(out, des, des->corners, des->libnames, des->numcorners);
+    else {
+	report_design_timing(out, des);
+	invalidate_design_paths(des);
+    }
+    profile_phase(NULL);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the worst setup and hold slack of the paths (one per	*/
+/* endpoint) through net or instance pin ("instance/pin")	*/
+/* "name" of design "des", bringing the timing up to date with	*/
+/* any changes first.  Without a clock period, the worst delay	*/
+/* is returned in place of the setup slack.  Return the		*/
+/* analyses found (VESTA_SETUP and VESTA_HOLD), whose slack is	*/
+/* set in "*setup" and "*hold", or -1 if there is no such net	*/
+/* or pin.  The paths are kept until the design changes, so	*/
+/* further queries do not search again.				*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_slack(vesta_design *des, char *name, double *setup, double *hold)
+{
+    netptr  testnet;
+    connptr testconn;
+    double  worst[2];
+    char    found[2];
+    int	    result;
+
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+    testnet = find_net_or_pin(des, name, &testconn);
+    if (testnet == NULL)
+	return design_error(des, "No such net or pin \"%s\"", name);
+
+    if ((des->numchanged > 0) || des->relink) update_design_timing(des);
+    find_worst_through(NULL, des, testnet, testconn, worst, found);
+
+    result = 0;
+    if (found[MAXIMUM_TIME]) {
+	*setup = (des->period > 0.0) ? des->period - worst[MAXIMUM_TIME] :
+		worst[MAXIMUM_TIME];
+	result |= VESTA_SETUP;
+    }
+    if (found[MINIMUM_TIME]) {
+	*hold = worst[MINIMUM_TIME];
+	result |= VESTA_HOLD;
+    }
+    return result;
+}
+
+/*--------------------------------------------------------------*/
+/* Find the setup and hold slack of net or instance pin		*/
+/* ("instance/pin") "name" of design "des" from the slack map,	*/
+/* which is made on the first query after the design changes	*/
+/* (see build_slack_map()), so that each further query is a	*/
+/* lookup.  The slack of a net is the worst of its pins.	*/
+/* Unlike vesta_slack(), the slack is that of the worst arrival	*/
+/* and required time at the pin rather than of the paths found,	*/
+/* and without a clock period, the setup slack is found against	*/
+/* the worst setup path delay.  Return value is as for		*/
+/* vesta_slack().						*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_map_slack(vesta_design *des, char *name, double *setup, double *hold)
+{
+    netptr  testnet;
+    connptr testconn;
+    double  slack[2];
+    int	    result;
+
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+    testnet = find_net_or_pin(des, name, &testconn);
+    if (testnet == NULL)
+	return design_error(des, "No such net or pin \"%s\"", name);
+
+    if ((des->numchanged > 0) || des->relink) update_design_timing(des);
+    if (!des->slacks.valid) build_slack_map(des);
+    find_map_slack(des, testnet, testconn, slack);
+
+    result = 0;
+    if (slack[MAXIMUM_TIME] != SLACK_NONE) {
+	*setup = slack[MAXIMUM_TIME];
+	result |= VESTA_SETUP;
+    }
+    if (slack[MINIMUM_TIME] != SLACK_NONE) {
+	*hold = slack[MINIMUM_TIME];
+	result |= VESTA_HOLD;
+    }
+    return result;
+}
+
+/*--------------------------------------------------------------*/
+/* Write the slack map of design "des" (the setup and hold	*/
+/* slack of every net and instance pin) to file "filename", in	*/
+/* text or binary form ("format" VESTA_SLACKMAP_TEXT or		*/
+/* VESTA_SLACKMAP_BINARY;  see vesta.h).  Return 0 on success,	*/
+/* or -1 on error.						*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_write_slack_map(vesta_design *des, char *filename, int format)
+{
+    FILE *fmap;
+    int result;
+
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+
+    profile_phase("slack map");
+    if ((des->numchanged > 0) || des->relink) update_design_timing(des);
+    if (!des->slacks.valid) build_slack_map(des);
+
+    result = -1;
+    fmap = fopen(filename, "w");
+    if (fmap != NULL) {
+	write_slack_map(fmap, des, format);
+	result = (ferror(fmap)) ? -1 : 0;
+	if (fclose(fmap) != 0) result = -1;
+    }
+    profile_phase(NULL);
+
+    if (result < 0)
+	return design_error(des, "Cannot write slack map %s", filename);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Bring the timing of design "des" up to date with the changes	*/
+/* made to it (see update_design_timing()).  This is done as	*/
+/* needed by vesta_slack(), so need not be called first.	*/
+/* Return the number of graph nodes evaluated, or -1 if no	*/
+/* netlist has been read.					*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_update(vesta_design *des)
+{
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+    return update_design_timing(des);
+}
+
+/*--------------------------------------------------------------*/
+/* Run the timing server on design "des" (see run_server()).	*/
+/* SIGPIPE is ignored while the server runs.  Return 0 when it	*/
+/* is done, or -1 if it cannot be started.			*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_serve(vesta_design *des, char *sockname)
+{
+    struct sigaction ignore, saved;
+    int result;
+
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+
+    // A client that closes its connection while a reply is being
+    // written must end only its own session, not the server.
+
+    memset(&ignore, 0, sizeof(ignore));
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPIPE, &ignore, &saved);
+    result = run_server(des, sockname);
+    sigaction(SIGPIPE, &saved, NULL);
+
+    if (result != 0)
+	return design_error(des, "Cannot run the timing server");
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Time "count" table lookups on each pin of the library of	*/
+/* design "des" (see bench_table_lookups()).			*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_bench_tables(vesta_design *des, int count)
+{
+    if (des->cells == NULL)
+	return design_error(des, "No library has been read");
+    bench_table_lookups(des->cells, count);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Check that design "des" may be changed, and prepare it for	*/
+/* incremental updates.  Return 0 if so, or -1.			*/
+/*--------------------------------------------------------------*/
+
+static int
+design_editable(design *des)
+{
+    if (des->graph == NULL)
+	return design_error(des, "No netlist has been read");
+    if (des->numcorners > 1)
+	return design_error(des, "A design with more than one process corner "
+		"cannot be changed");
+
+    // Keep the levelized search results for incremental updates
+
+    index_design_names(des);
+    des->incremental = 1;
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Set the clock period of design "des" to "period" ps.		*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_set_period(vesta_design *des, double period)
+{
+    des->period = period;
+    des->slacks.valid = 0;
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Set the load on each module output of design "des" to	*/
+/* "outload" fF, in every process corner.  The whole design is	*/
+/* timed again.							*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_set_load(vesta_design *des, double outload)
+{
+    int c;
+
+    des->outload = outload;
+    if (des->netlist != NULL) {
+	computeLoads(des->netlist, des->instlist, des->outload);
+	for (c = 1; c < des->numcorners; c++)
+	    compute_corner_loads(des->corners[c], des->graph, des->instlist,
+			des->outload);
+	invalidate_design_arrivals(des);
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Change the cell of instance "instname" of design "des" to	*/
+/* "cellname", which must have the same pins (see		*/
+/* eco_swap_cell()).  Return 0 on success, or -1 on error.	*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_swap_cell(vesta_design *des, char *instname, char *cellname)
+{
+    instptr testinst;
+    cellptr newcell;
+
+    if (design_editable(des) < 0) return -1;
+    testinst = (instptr)hash_lookup(&des->insts, instname, NULL);
+    if (testinst == NULL)
+	return design_error(des, "No such instance \"%s\"", instname);
+    newcell = find_cell(des, cellname);
+    if (newcell == NULL)
+	return design_error(des, "No such cell \"%s\"", cellname);
+    if (eco_swap_cell(des, testinst, newcell) != 0)
+	return design_error(des, "Cell \"%s\" does not match the pins of \"%s\"",
+		cellname, testinst->refcell->name);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Move instance pin "pinname" ("instance/pin") of design "des"	*/
+/* to net "netname" (see eco_reconnect()).  Return 0 on		*/
+/* success, or -1 on error.					*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_reconnect(vesta_design *des, char *pinname, char *netname)
+{
+    connptr testconn;
+    netptr testnet;
+
+    if (design_editable(des) < 0) return -1;
+    testconn = find_instance_pin(&des->insts, pinname);
+    if (testconn == NULL)
+	return design_error(des, "No such instance pin \"%s\"", pinname);
+    testnet = (netptr)hash_lookup(&des->nets, netname, NULL);
+    if (testnet == NULL)
+	return design_error(des, "No such net \"%s\"", netname);
+    if (eco_reconnect(des, testconn, testnet) != 0)
+	return design_error(des, "Net \"%s\" already has a driver", netname);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Buffer net "netname" of design "des" with a new instance	*/
+/* "instname" of cell "cellname", driving a new net "newname"	*/
+/* (see eco_insert_buffer()).  The "numsinks" instance pins in	*/
+/* "sinks" ("instance/pin") are moved to the new net, or all	*/
+/* instance pins on the net if "numsinks" is 0.  Return 0 on	*/
+/* success, or -1 on error.					*/
+/*--------------------------------------------------------------*/
+
+int
+vesta_insert_buffer(vesta_design *des, char *netname, char *cellname,
+		char *instname, char *newname, char **sinks, int numsinks)
+{
+    netptr  testnet;
+    cellptr bufcell;
+    instptr newinst;
+    connptr *sinkconns;
+    int	    i;
+
+    if (design_editable(des) < 0) return -1;
+    testnet = (netptr)hash_lookup(&des->nets, netname, NULL);
+    if (testnet == NULL)
+	return design_error(des, "No such net \"%s\"", netname);
+    bufcell = find_cell(des, cellname);
+    if (bufcell == NULL)
+	return design_error(des, "No such cell \"%s\"", cellname);
+    if (hash_lookup(&des->insts, instname, NULL) != NULL)
+	return design_error(des, "Instance \"%s\" already exists", instname);
+    if (hash_lookup(&des->nets, newname, NULL) != NULL)
+	return design_error(des, "Net \"%s\" already exists", newname);
+
+    // A net cannot have more sinks than receivers;  any more are ignored
+
+    if (numsinks > testnet->fanout) numsinks = testnet->fanout;
+    sinkconns = (connptr *)malloc((numsinks + 1) * sizeof(connptr));
+    for (i = 0; i < numsinks; i++) {
+	sinkconns[i] = find_instance_pin(&des->insts, sinks[i]);
+	if (sinkconns[i] == NULL) {
+	    free(sinkconns);
+	    return design_error(des, "No such instance pin \"%s\"", sinks[i]);
+	}
+    }
+
+    newinst = eco_insert_buffer(des, testnet, bufcell, instname, newname,
+		sinkconns, numsinks);
+    free(sinkconns);
+    if (newinst == NULL)
+	return design_error(des, "Cannot buffer net \"%s\" with cell \"%s\"",
+		netname, cellname);
+    hash_insert(&des->insts, newinst->name, NULL, newinst);
+    hash_insert(&des->nets, newinst->out_connects->refnet->name, NULL,
+		newinst->out_connects->refnet);
+    return 0;
+}
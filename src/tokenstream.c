@@ -0,0 +1,612 @@
+/*--------------------------------------------------------------*/
+/* tokenstream.c ---						*/
+/*								*/
+/*	Tokenizer shared by the liberty and verilog readers of	*/
+/*	vesta (see libvesta.c) and the liberty reader of	*/
+/*	liberty2tech (see tokenstream.h), with decompression	*/
+/*	of gzip and zstd input.					*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+#ifdef HAVE_LIBZSTD
+#include <zstd.h>
+#endif
+
+#include "tokenstream.h"
+
+// Whitespace other than a line end
+#define IS_BLANK(c) (((c) == ' ') || ((c) == '\t') || ((c) == '\r') || \
+		((c) == '\v') || ((c) == '\f'))
+
+// Size of the blocks written by a decompressing thread
+#define TOKEN_CHUNK_SIZE	(1 << 18)
+
+/*--------------------------------------------------------------*/
+/* Write "count" bytes of "buf" to the pipe "fd".  Return -1	*/
+/* if the pipe has been closed by the reader.			*/
+/*--------------------------------------------------------------*/
+
+static int
+tokenstream_write(int fd, char *buf, size_t count)
+{
+    ssize_t n;
+
+    while (count > 0) {
+	n = write(fd, buf, count);
+	if (n < 0) {
+	    if (errno == EINTR) continue;
+	    return -1;
+	}
+	buf += n;
+	count -= n;
+    }
+    return 0;
+}
+
+#ifdef HAVE_LIBZ
+
+/*--------------------------------------------------------------*/
+/* Decompress the gzip input of "ts" into its pipe.		*/
+/*--------------------------------------------------------------*/
+
+static void
+tokenstream_gunzip(tokenstream *ts)
+{
+    gzFile gz;
+    char   *out;
+    int    n, status;
+
+    gz = gzdopen(ts->infd, "rb");
+    if (gz == NULL) {
+	close(ts->infd);
+	ts->error = 1;
+	return;
+    }
+    gzbuffer(gz, TOKEN_CHUNK_SIZE);
+    out = (char *)malloc(TOKEN_CHUNK_SIZE);
+
+    // gzread() reads each member of a multi-member file in turn, and
+    // gzclose() reports a file that ends in the middle of a member.
+
+    while ((n = gzread(gz, out, TOKEN_CHUNK_SIZE)) > 0)
+	if (tokenstream_write(ts->outfd, out, n) < 0) break;
+    status = gzclose(gz);
+    if ((n < 0) || ((n == 0) && (status != Z_OK)))
+	ts->error = 1;
+    free(out);
+}
+
+#endif /* HAVE_LIBZ */
+
+#ifdef HAVE_LIBZSTD
+
+/*--------------------------------------------------------------*/
+/* Decompress the zstd input of "ts" into its pipe.		*/
+/*--------------------------------------------------------------*/
+
+static void
+tokenstream_unzstd(tokenstream *ts)
+{
+    ZSTD_DCtx	   *dctx;
+    ZSTD_inBuffer  in;
+    ZSTD_outBuffer out;
+    size_t  insize, outsize, ret;
+    ssize_t got;
+    char    *inbuf, *outbuf, closed;
+
+    insize = ZSTD_DStreamInSize();
+    outsize = ZSTD_DStreamOutSize();
+    inbuf = (char *)malloc(insize);
+    outbuf = (char *)malloc(outsize);
+    dctx = ZSTD_createDCtx();
+
+    // The decompressor does not take the last byte of a frame until
+    // all of the frame has been written out, so the input is used up
+    // only when the output is complete.  "ret" is 0 at the end of a
+    // frame, and frames following it are read in turn.
+
+    ret = 0;
+    closed = 0;
+    while (!closed && ((got = read(ts->infd, inbuf, insize)) != 0)) {
+	if (got < 0) {
+	    if (errno == EINTR) continue;
+	    ts->error = 1;
+	    break;
+	}
+	in.src = inbuf;
+	in.size = got;
+	in.pos = 0;
+	while (in.pos < in.size) {
+	    out.dst = outbuf;
+	    out.size = outsize;
+	    out.pos = 0;
+	    ret = ZSTD_decompressStream(dctx, &out, &in);
+	    if (ZSTD_isError(ret)) {
+		ts->error = 1;
+		closed = 1;
+		break;
+	    }
+	    if (tokenstream_write(ts->outfd, outbuf, out.pos) < 0) {
+		closed = 1;
+		break;
+	    }
+	}
+    }
+    if (!closed && (ret != 0)) ts->error = 1;
+
+    ZSTD_freeDCtx(dctx);
+    free(inbuf);
+    free(outbuf);
+    close(ts->infd);
+}
+
+#endif /* HAVE_LIBZSTD */
+
+/*--------------------------------------------------------------*/
+/* Thread decompressing the input of "ts" (passed as "arg").	*/
+/* The pipe is closed at the end, which the reader sees as the	*/
+/* end of the input.						*/
+/*--------------------------------------------------------------*/
+
+static void *
+tokenstream_thread(void *arg)
+{
+    tokenstream *ts = (tokenstream *)arg;
+
+#ifdef HAVE_LIBZ
+    if (ts->format == TOKEN_GZIP) tokenstream_gunzip(ts);
+#endif
+#ifdef HAVE_LIBZSTD
+    if (ts->format == TOKEN_ZSTD) tokenstream_unzstd(ts);
+#endif
+    close(ts->outfd);
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Start decompressing the compressed input of "ts" into the	*/
+/* pipe it reads from, on a thread if the program was built	*/
+/* with the library for the format, or else by running the	*/
+/* gzip or zstd program.  Return 0 on success, or -1 if the	*/
+/* decompressor cannot be started.				*/
+/*--------------------------------------------------------------*/
+
+static int
+tokenstream_decompress(tokenstream *ts)
+{
+    sigset_t pipesig, oldsig;
+    char *prog;
+    int result;
+
+    ts->threaded = 0;
+#ifdef HAVE_LIBZ
+    if (ts->format == TOKEN_GZIP) ts->threaded = 1;
+#endif
+#ifdef HAVE_LIBZSTD
+    if (ts->format == TOKEN_ZSTD) ts->threaded = 1;
+#endif
+
+    if (ts->threaded) {
+
+	// A stream closed before all of it is read ends the thread
+	// with a failed write to the pipe.  SIGPIPE is blocked in the
+	// thread so that this does not also end the program.
+
+	sigemptyset(&pipesig);
+	sigaddset(&pipesig, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &pipesig, &oldsig);
+	result = pthread_create(&ts->thread, NULL, tokenstream_thread, ts);
+	pthread_sigmask(SIG_SETMASK, &oldsig, NULL);
+	return (result == 0) ? 0 : -1;
+    }
+
+    prog = (ts->format == TOKEN_GZIP) ? "gzip" : "zstd";
+    ts->child = fork();
+    if (ts->child < 0) return -1;
+    if (ts->child == 0) {
+	// All other descriptors of the streams are closed on exec
+	dup2(ts->infd, 0);
+	dup2(ts->outfd, 1);
+	execlp(prog, prog, "-dc", (char *)NULL);
+	fprintf(stderr, "Cannot run %s to read compressed input\n", prog);
+	_exit(1);
+    }
+    close(ts->infd);
+    close(ts->outfd);
+    return 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Open file "filename" for reading tokens.  A file compressed	*/
+/* with gzip or zstd is decompressed as it is read.  Return	*/
+/* NULL if the file cannot be opened.				*/
+/*--------------------------------------------------------------*/
+
+tokenstream *
+tokenstream_open(char *filename)
+{
+    tokenstream *ts;
+    unsigned char magic[4];
+    int fd, format, pipefd[2];
+
+    fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    // Find the format from the signature at the start of the file.
+    // Input that cannot be read this way (a pipe) is taken as plain.
+
+    format = TOKEN_PLAIN;
+    if (pread(fd, magic, 4, 0) == 4) {
+	if ((magic[0] == 0x1f) && (magic[1] == 0x8b))
+	    format = TOKEN_GZIP;
+	else if ((magic[0] == 0x28) && (magic[1] == 0xb5) && (magic[2] == 0x2f)
+			&& (magic[3] == 0xfd))
+	    format = TOKEN_ZSTD;
+    }
+
+    ts = (tokenstream *)malloc(sizeof(tokenstream));
+    ts->format = format;
+    ts->error = 0;
+    ts->threaded = 0;
+    ts->child = 0;
+    ts->onerror = NULL;
+    ts->infd = ts->outfd = -1;
+    if (format == TOKEN_PLAIN)
+	ts->fd = fd;
+    else {
+	if (pipe(pipefd) < 0) {
+	    close(fd);
+	    free(ts);
+	    return NULL;
+	}
+	fcntl(pipefd[0], F_SETFD, FD_CLOEXEC);
+	fcntl(pipefd[1], F_SETFD, FD_CLOEXEC);
+	ts->fd = pipefd[0];
+	ts->outfd = pipefd[1];
+	ts->infd = fd;
+	if (tokenstream_decompress(ts) < 0) {
+	    close(pipefd[0]);
+	    close(pipefd[1]);
+	    close(fd);
+	    free(ts);
+	    return NULL;
+	}
+    }
+
+    ts->size = TOKEN_BUFFER_SIZE;
+    ts->buf = (char *)malloc(ts->size + 1);
+    ts->eof = 0;
+    ts->line = 0;
+
+    // Start at the end of an empty line, so that the first line is
+    // begun in the same way as every other line.
+
+    ts->buf[0] = '\n';
+    ts->buf[1] = '\0';
+    ts->pos = 0;
+    ts->end = ts->len = 1;
+    ts->endchar = '\0';
+    ts->holdpos = 0;
+    ts->hold = '\n';
+    return ts;
+}
+
+/*--------------------------------------------------------------*/
+/* Wait for the decompressor of "ts" (if any) to end, and set	*/
+/* the error flag of "ts" if it found the input corrupt.  This	*/
+/* is done at the end of the input, or when the stream is	*/
+/* closed.							*/
+/*--------------------------------------------------------------*/
+
+static void
+tokenstream_reap(tokenstream *ts)
+{
+    int status;
+
+    if (ts->threaded) {
+	pthread_join(ts->thread, NULL);
+	ts->threaded = 0;
+    }
+    else if (ts->child > 0) {
+	// gzip exits with status 2 on a warning, such as for trailing
+	// garbage.  A decompressor stopped early by the closed pipe
+	// fails, which is not an error unless all of the input was read.
+
+	waitpid(ts->child, &status, 0);
+	if (ts->eof && (!WIFEXITED(status) || (WEXITSTATUS(status) == 1)))
+	    ts->error = 1;
+	ts->child = 0;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Close a file opened by tokenstream_open().  Return 0, or -1	*/
+/* if the file was compressed and is corrupt or truncated.	*/
+/*--------------------------------------------------------------*/
+
+int
+tokenstream_close(tokenstream *ts)
+{
+    int result;
+
+    // Closing the pipe ends a decompressor that is still writing
+
+    close(ts->fd);
+    tokenstream_reap(ts);
+    result = (ts->error) ? -1 : 0;
+    free(ts->buf);
+    free(ts);
+    return result;
+}
+
+/*--------------------------------------------------------------*/
+/* Drop the input before position "keep" in the buffer, moving	*/
+/* the rest down, and read more input, up to the end of at	*/
+/* least one more complete line.  A line is not complete if it	*/
+/* ends in a line continuation.  Return 0 if there is no more	*/
+/* input.							*/
+/*--------------------------------------------------------------*/
+
+static int
+tokenstream_fill(tokenstream *ts, size_t keep)
+{
+    size_t  from, i, j;
+    ssize_t got;
+
+    if (ts->eof && (ts->end == ts->len)) return 0;
+
+    ts->buf[ts->end] = ts->endchar;
+    memmove(ts->buf, ts->buf + keep, ts->len - keep);
+    ts->len -= keep;
+    ts->end -= keep;
+
+    from = ts->end;
+    while (1) {
+	// Find the last line end that is not escaped
+
+	for (i = ts->len; i > from; i--) {
+	    if (ts->buf[i - 1] != '\n') continue;
+	    for (j = i - 1; (j > 0) && IS_BLANK(ts->buf[j - 1]); j--);
+	    if ((j == 0) || (ts->buf[j - 1] != '\\')) break;
+	}
+	if (i > from) break;
+	if (ts->eof) {
+	    i = ts->len;
+	    break;
+	}
+
+	if (ts->len == ts->size) {
+	    ts->size <<= 1;
+	    ts->buf = (char *)realloc(ts->buf, ts->size + 1);
+	}
+	got = read(ts->fd, ts->buf + ts->len, ts->size - ts->len);
+	if (got <= 0) {
+	    // The decompressor has closed the pipe, and has all but
+	    // ended, so its result can be had now.
+
+	    ts->eof = 1;
+	    tokenstream_reap(ts);
+	}
+	else {
+	    from = ts->len;
+	    ts->len += got;
+	}
+    }
+
+    from = ts->end;
+    ts->end = i;
+    ts->endchar = ts->buf[i];
+    ts->buf[i] = '\0';
+    return (i > from);
+}
+
+/*--------------------------------------------------------------*/
+/* Return the length of the line continuation at "ptr" (a	*/
+/* backslash followed by nothing but whitespace to the end of	*/
+/* the line), or 0 if there is none.  Line continuations are	*/
+/* skipped wherever they are found, joining the lines.		*/
+/*--------------------------------------------------------------*/
+
+static int
+tokenstream_continues(char *ptr)
+{
+    char *eptr;
+
+    if (*ptr != '\\') return 0;
+    for (eptr = ptr + 1; IS_BLANK(*eptr); eptr++);
+    return (*eptr == '\n') ? (int)(eptr + 1 - ptr) : 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the position of the character following position	*/
+/* "pos", past any line continuations.				*/
+/*--------------------------------------------------------------*/
+
+static size_t
+tokenstream_next(tokenstream *ts, size_t pos)
+{
+    int n;
+
+    pos++;
+    while ((n = tokenstream_continues(ts->buf + pos)) > 0) pos += n;
+    return pos;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the position of the first character at or after	*/
+/* "pos" that is not whitespace, stopping at the end of the	*/
+/* line.							*/
+/*--------------------------------------------------------------*/
+
+static size_t
+tokenstream_skip(tokenstream *ts, size_t pos)
+{
+    int n;
+
+    while (1) {
+	if (IS_BLANK(ts->buf[pos]))
+	    pos++;
+	else if ((n = tokenstream_continues(ts->buf + pos)) > 0) {
+	    pos += n;
+	    ts->line++;
+	}
+	else
+	    return pos;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Grab a token from the input					*/
+/* Return the token, or NULL if we have reached end-of-file.	*/
+/* At the end of compressed input that is corrupt or truncated,	*/
+/* the parse is ended by a jump to "onerror", if it is set, as	*/
+/* the parsers do not expect the input to end mid-statement.	*/
+/*								*/
+/* The token is left in place in the input buffer, ended by a	*/
+/* null, and is valid until the next call.  Where a token	*/
+/* spans a line end or a line continuation, the rest of the	*/
+/* token is moved down over it.					*/
+/*--------------------------------------------------------------*/
+
+char *
+advancetoken(tokenstream *ts, char delimiter)
+{
+    char   *buf;
+    size_t pos, start, tend, keep, next;
+    int	   commentblock, concat, nest, n;
+    char   c;
+
+    ts->buf[ts->holdpos] = ts->hold;
+    buf = ts->buf;
+    pos = start = tend = ts->pos;
+
+    commentblock = 0;
+    concat = 0;
+    nest = 0;
+    while (1) {		/* Keep processing until we get a token or hit EOF */
+
+	if ((buf[pos] == '/') && (buf[tokenstream_next(ts, pos)] == '*'))
+	    commentblock = 1;
+
+	if (commentblock == 1) {
+	    while (((c = buf[pos]) != '\n') && (c != '\0')) {
+		if ((c == '*') && (buf[next = tokenstream_next(ts, pos)] == '/')) {
+		    for (pos++; pos < next; pos += tokenstream_continues(buf + pos))
+			ts->line++;
+		    pos++;
+		    commentblock = 0;
+		    break;
+		}
+		if ((n = tokenstream_continues(buf + pos)) > 0) {
+		    pos += n;
+		    ts->line++;
+		}
+		else
+		    pos++;
+	    }
+	}
+
+	if ((buf[pos] == '\n') || (buf[pos] == '\0')) {
+
+	    // Go on to the next line, reading more input if the buffer
+	    // is used up.  Any part of a token found so far is kept.
+
+	    if (pos < ts->end) pos++;
+	    if (pos == ts->end) {
+		keep = (concat) ? start : pos;
+		if (!tokenstream_fill(ts, keep)) {
+		    ts->line++;
+		    ts->pos = ts->holdpos = ts->end;
+		    ts->hold = '\0';
+		    if (ts->error && (ts->onerror != NULL))
+			longjmp(*ts->onerror, 1);
+		    return NULL;
+		}
+		buf = ts->buf;
+		pos -= keep;
+		start -= keep;
+		tend -= keep;
+	    }
+	    ts->line++;
+	}
+
+	if (commentblock == 1) continue;
+
+	pos = tokenstream_skip(ts, pos);
+	if (concat == 0)
+	    start = tend = pos;
+
+	// Find the next token and return just the token.  Update pos
+	// to the position just beyond the token.  All delimiters like
+	// parentheses, quotes, etc., are returned as single tokens
+
+	// If delimiter is declared, then we stop when we reach the
+	// delimiter character, and return all the text preceding it
+	// as the token.  If delimiter is 0, then we look for standard
+	// delimiters, and separate them out and return them as tokens
+	// if found.
+
+	while (1) {
+	    c = buf[pos];
+	    if ((c == '\n') || (c == '\0'))
+		break;
+	    if ((c == '/') && (buf[tokenstream_next(ts, pos)] == '*'))
+		break;
+	    if ((c == '\\') && ((n = tokenstream_continues(buf + pos)) > 0)) {
+		pos += n;
+		ts->line++;
+		continue;
+	    }
+	    if ((delimiter != 0) && (c == delimiter)) {
+		if (nest > 0)
+		    nest--;
+		else
+		    break;
+	    }
+
+	    // Watch for nested delimiters!
+	    if ((delimiter == '}') && (c == '{')) nest++;
+	    if ((delimiter == ')') && (c == '(')) nest++;
+
+	    if (delimiter == 0) {
+		if ((c == ' ') || (c == '\t'))
+		    break;
+		if ((c == '(') || (c == ')') || (c == '{') || (c == '}') ||
+			(c == '\"') || (c == ':') || (c == ';')) {
+		    if (tend == start) buf[tend++] = buf[pos++];
+		    break;
+		}
+	    }
+	    buf[tend++] = buf[pos++];
+	}
+	if ((delimiter != 0) && (buf[pos] != delimiter))
+	    concat = 1;
+	else if (delimiter != 0)
+	    break;
+	else if (tend > start)
+	    break;
+    }
+    if (delimiter != 0) pos++;
+    ts->pos = tokenstream_skip(ts, pos);
+
+    // Final:  Remove trailing whitespace, and end the token with a
+    // null, keeping the character it replaces for the next call.
+
+    while ((tend > start) && isspace(buf[tend - 1])) tend--;
+    ts->holdpos = tend;
+    ts->hold = buf[tend];
+    buf[tend] = '\0';
+    return buf + start;
+}
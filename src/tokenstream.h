@@ -0,0 +1,67 @@
+/*--------------------------------------------------------------*/
+/* tokenstream.h ---						*/
+/*								*/
+/*	Tokenizer for the liberty and verilog readers of vesta	*/
+/*	and liberty2tech.  The input is read in large chunks	*/
+/*	into a buffer, and each token is returned in place in	*/
+/*	that buffer, so tokens are not copied, and comments and	*/
+/*	line continuations are handled in the same scan.  All	*/
+/*	state is kept in the stream, so any number of files	*/
+/*	may be read at once, by different threads.		*/
+/*								*/
+/*	A file compressed with gzip or zstd is decompressed	*/
+/*	as it is read, by a separate thread (or, if the program	*/
+/*	was built without the library for the format, by the	*/
+/*	gzip or zstd program), while the tokens are read.	*/
+/*--------------------------------------------------------------*/
+
+#ifndef _TOKENSTREAM_H
+#define _TOKENSTREAM_H
+
+#include <stddef.h>
+#include <setjmp.h>
+#include <sys/types.h>
+#include <pthread.h>
+
+// Size of the first input buffer.  The buffer grows to hold the longest
+// token, or the longest line, if that is longer.
+
+#define TOKEN_BUFFER_SIZE	(1 << 20)
+
+// Formats of the input file, found from its first bytes
+
+#define TOKEN_PLAIN		0
+#define TOKEN_GZIP		1
+#define TOKEN_ZSTD		2
+
+// An input file being tokenized.  "buf" holds the input from the start
+// of the token being scanned, and complete lines of it up to "end".
+
+typedef struct _tokenstream {
+   char	   *buf;	/* Input, with a null at "end" */
+   size_t  size;	/* Size of "buf", less one byte for the null */
+   size_t  pos;		/* Next character to scan */
+   size_t  end;		/* End of the complete lines in "buf" */
+   size_t  len;		/* End of the input read into "buf" */
+   size_t  holdpos;	/* Position of the null ending the last token */
+   char	   hold;	/* Character replaced by that null */
+   char	   endchar;	/* Character replaced by the null at "end" */
+   char	   eof;		/* 1 once the end of the input has been read */
+   char	   error;	/* 1 if the compressed input is corrupt */
+   int	   fd;		/* Input file, or decompressed input (pipe) */
+   int	   line;	/* Number of lines begun, for messages */
+   int	   format;	/* TOKEN_PLAIN, TOKEN_GZIP or TOKEN_ZSTD */
+   int	   infd;	/* Compressed input file */
+   int	   outfd;	/* Pipe written by the decompressor */
+   char	   threaded;	/* 1 if decompressed by "thread" */
+   pthread_t thread;
+   pid_t   child;	/* Decompressing process, if not threaded */
+   jmp_buf *onerror;	/* If not NULL, where advancetoken() returns to */
+			/* at the end of corrupt or truncated input */
+} tokenstream;
+
+extern tokenstream *tokenstream_open(char *filename);
+extern int  tokenstream_close(tokenstream *ts);
+extern char *advancetoken(tokenstream *ts, char delimiter);
+
+#endif /* _TOKENSTREAM_H */
@@ -0,0 +1,140 @@
+/*--------------------------------------------------------------*/
+/* vesta.h ---							*/
+/*								*/
+/*	C interface to libvesta, the static timing analyzer	*/
+/*	of the vesta tool, for programs that time a design	*/
+/*	in-process instead of running vesta and reading its	*/
+/*	report.  A design is read from a liberty file and a	*/
+/*	structural verilog netlist, timed, queried for the	*/
+/*	slack through a net or pin, and changed in place;  the	*/
+/*	timing is then brought up to date incrementally.	*/
+/*								*/
+/*	A typical use is:					*/
+/*								*/
+/*	    vesta_init(NULL);					*/
+/*	    des = vesta_create(period, 0.0);			*/
+/*	    if (vesta_read_library(des, "cells.lib", NULL) < 0)	*/
+/*		fprintf(stderr, "%s\n", vesta_error(des));	*/
+/*	    vesta_read_netlist(des, "top.v");			*/
+/*	    vesta_slack(des, "net1", &setup, &hold);		*/
+/*	    vesta_swap_cell(des, "g1", "INVX4");		*/
+/*	    vesta_slack(des, "net1", &setup, &hold);		*/
+/*	    vesta_free(des);					*/
+/*								*/
+/*	Functions returning an int return a negative value on	*/
+/*	error, and the message is kept in the design (see	*/
+/*	vesta_error()).  The options are shared by all designs	*/
+/*	in the program.  A design may be used by one thread at	*/
+/*	a time, although the library uses threads internally.	*/
+/*	Times are in ps, and loads in fF.  Progress messages	*/
+/*	go to stderr in verbose mode only, unless another	*/
+/*	stream is given with vesta_set_log().			*/
+/*--------------------------------------------------------------*/
+
+#ifndef _VESTA_H
+#define _VESTA_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// A design loaded for analysis (opaque)
+
+typedef struct _design vesta_design;
+
+// Pruning of the depth-first path search.  VESTA_PRUNE_DELAY stops on
+// any arrival no worse than the worst delay seen at a connection (fast,
+// but not exact), VESTA_PRUNE_PARETO stops only on an arrival whose
+// delay and transition time are both no worse than those of an arrival
+// already searched (exact for monotonic tables), and VESTA_PRUNE_NONE
+// searches every path.
+
+#define VESTA_PRUNE_DELAY	0
+#define VESTA_PRUNE_PARETO	1
+#define VESTA_PRUNE_NONE	2
+
+// Analyses found by vesta_slack()
+
+#define VESTA_SETUP		0x01
+#define VESTA_HOLD		0x02
+
+// Forms of the slack map file written by vesta_write_slack_map()
+
+#define VESTA_SLACKMAP_TEXT	0
+#define VESTA_SLACKMAP_BINARY	1
+
+// The binary slack map file is a header, "numrecords" records, and the
+// record names (each ending in a null) at offset "names" in the file.
+// The records hold the slack of each net, then of each instance pin
+// ("instance/pin").  The fields have the same sizes on every machine,
+// with no padding;  values are in the byte order of the machine that
+// wrote the file.  Slack is infinite where no path is timed.
+
+#define VESTA_SLACKMAP_MAGIC	"VESTASLK"
+#define VESTA_SLACKMAP_VERSION	1
+
+#define VESTA_SLACKMAP_NET	0
+#define VESTA_SLACKMAP_PIN	1
+
+typedef struct _vesta_slackmap_header {
+   char	    magic[8];	/* VESTA_SLACKMAP_MAGIC, not null terminated */
+   int32_t  version;	/* VESTA_SLACKMAP_VERSION */
+   int32_t  numrecords;
+   double   period;	/* Clock period of the setup slack, in ps */
+   int64_t  names;	/* Offset of the names from the start of the file */
+} vesta_slackmap_header;
+
+typedef struct _vesta_slackmap_record {
+   uint32_t name;	/* Offset of the name from the start of the names */
+   uint32_t type;	/* VESTA_SLACKMAP_NET or VESTA_SLACKMAP_PIN */
+   float    setup;	/* Setup slack, in ps */
+   float    hold;	/* Hold slack, in ps */
+} vesta_slackmap_record;
+
+// Options of the analysis
+
+typedef struct _vestaopts {
+   int	verbose;	/* Level of debug output generated (on stdout) */
+   int	pruning;	/* Path search pruning (VESTA_PRUNE_DELAY, etc.) */
+   int	levelized;	/* 1 for the levelized (graph-based) search */
+   int	threads;	/* Number of path search threads */
+   int	paths;		/* Number of paths reported */
+   int	perendpoint;	/* Paths reported per endpoint (0 = any) */
+   int	profile;	/* 1 to profile each phase (see vesta_profile_write()) */
+} vestaopts;
+
+/* Options and library state */
+
+extern void vesta_default_options(vestaopts *opts);
+extern void vesta_init(vestaopts *opts);
+extern int  vesta_read_loop_breaks(char *filename);
+extern void vesta_profile_write(FILE *out, char *jsonname);
+
+/* Loading a design */
+
+extern vesta_design *vesta_create(double period, double outload);
+extern void vesta_set_log(vesta_design *des, FILE *log);
+extern int  vesta_read_library(vesta_design *des, char *libname, char *cachename);
+extern int  vesta_read_netlist(vesta_design *des, char *filename);
+extern int  vesta_add_corner(vesta_design *des, char *libname);
+extern char *vesta_error(vesta_design *des);
+extern void vesta_free(vesta_design *des);
+
+/* Timing and queries */
+
+extern int  vesta_report_timing(vesta_design *des, FILE *out);
+extern int  vesta_slack(vesta_design *des, char *name, double *setup, double *hold);
+extern int  vesta_map_slack(vesta_design *des, char *name, double *setup, double *hold);
+extern int  vesta_write_slack_map(vesta_design *des, char *filename, int format);
+extern int  vesta_update(vesta_design *des);
+extern int  vesta_serve(vesta_design *des, char *sockname);
+
+/* Changes to the design */
+
+extern int  vesta_set_period(vesta_design *des, double period);
+extern int  vesta_set_load(vesta_design *des, double outload);
+extern int  vesta_swap_cell(vesta_design *des, char *instname, char *cellname);
+extern int  vesta_reconnect(vesta_design *des, char *pinname, char *netname);
+extern int  vesta_insert_buffer(vesta_design *des, char *netname, char *cellname,
+		char *instname, char *newname, char **sinks, int numsinks);
+
+#endif /* _VESTA_H */
@@ -0,0 +1,617 @@
+/*--------------------------------------------------------------*/
+/* vestagen.c ---						*/
+/*								*/
+/*	Generate a synthetic structural verilog netlist for	*/
+/*	benchmarking the vesta static timing analyzer.  The	*/
+/*	netlist uses the cell set common to the OSU osu035 and	*/
+/*	osu050 standard cell libraries, so the same netlist	*/
+/*	can be timed with either library.			*/
+/*								*/
+/*	Options are supplied as command-line arguments:		*/
+/*								*/
+/*		-n <value>	Number of instances		*/
+/*		-d <value>	Logic depth (gate levels)	*/
+/*		-f <value>	Maximum fanout of a net		*/
+/*		-g <value>	Percent of gate inputs taken	*/
+/*				from a few high-fanout nets	*/
+/*		-r <value>	Percent of instances that are	*/
+/*				flip-flops			*/
+/*		-c <value>	Percent of gate inputs that	*/
+/*				reconverge with another input	*/
+/*		-l <value>	Number of combinational loops	*/
+/*		-t <value>	Buffer the clock into a tree	*/
+/*				with this maximum fanout	*/
+/*		-k <value>	Number of clock inputs, each	*/
+/*				clocking an equal share of the	*/
+/*				flip-flops			*/
+/*		-i <value>	Number of primary inputs	*/
+/*		-o <value>	Number of primary outputs	*/
+/*		-s <value>	Random seed			*/
+/*		-m <name>	Module name			*/
+/*								*/
+/*	The netlist is written to the file named by the last	*/
+/*	argument, or to stdout if there is none.  The random	*/
+/*	number generator is part of this file, so the same	*/
+/*	options and seed always produce the same netlist on	*/
+/*	any platform.						*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*--------------------------------------------------------------*/
+/* Cells used in the netlist, with the relative frequency of	*/
+/* each among the combinational gates.				*/
+/*--------------------------------------------------------------*/
+
+typedef struct _gatecell {
+   char *name;
+   int	 numin;
+   char *pins[4];	/* Input pin names */
+   char *out;		/* Output pin name */
+   int	 weight;
+} gatecell;
+
+gatecell gatecells[] = {
+   {"INVX1",   1, {"A"},		"Y", 14},
+   {"BUFX2",   1, {"A"},		"Y",  4},
+   {"NAND2X1", 2, {"A", "B"},		"Y", 16},
+   {"NOR2X1",  2, {"A", "B"},		"Y", 12},
+   {"AND2X1",  2, {"A", "B"},		"Y",  6},
+   {"OR2X1",   2, {"A", "B"},		"Y",  6},
+   {"XOR2X1",  2, {"A", "B"},		"Y",  5},
+   {"XNOR2X1", 2, {"A", "B"},		"Y",  3},
+   {"NAND3X1", 3, {"A", "B", "C"},	"Y",  6},
+   {"NOR3X1",  3, {"A", "B", "C"},	"Y",  4},
+   {"AOI21X1", 3, {"A", "B", "C"},	"Y",  8},
+   {"OAI21X1", 3, {"A", "B", "C"},	"Y",  8},
+   {"AOI22X1", 4, {"A", "B", "C", "D"},	"Y",  3},
+   {"OAI22X1", 4, {"A", "B", "C", "D"},	"Y",  3},
+   {"MUX2X1",  3, {"A", "B", "S"},	"Y",  2},
+   {NULL,      0, {NULL},		NULL, 0}
+};
+
+#define FLOPCELL	"DFFPOSX1"
+#define BUFCELL		"BUFX2"
+#define CLKBUFCELL	"CLKBUF1"
+
+/* Maximum number of levels in a generated clock tree */
+#define MAXCLKLEVELS	32
+
+/* Number of primary inputs used as high-fanout ("global") nets */
+#define NUMGLOBAL	4
+
+/* Number of tries to find a driver that is below the maximum fanout */
+#define FANOUT_TRIES	4
+
+/*--------------------------------------------------------------*/
+/* Nets are numbered:  0 is the clock, followed by the primary	*/
+/* inputs, the flip-flop outputs, and the gate outputs.		*/
+/*--------------------------------------------------------------*/
+
+typedef struct _gate {
+   short cell;		/* Index into gatecells[] */
+   short level;
+   int	 in[4];		/* Nets driving each input */
+   char	 inloop;	/* Gate is part of a generated loop */
+} gate;
+
+typedef struct _netgen {
+   int	 numinputs;
+   int	 numoutputs;
+   int	 numflops;
+   int	 numgates;
+   int	 depth;
+   int	 maxfanout;
+   int	 globalpct;
+   int	 reconvpct;
+   int	 numloops;
+   int	 clockfanout;	/* Maximum fanout of a clock tree net, or 0 */
+   int	 numclocks;	/* Number of clock inputs */
+   int	 firstflop;	/* Net number of the first flip-flop output */
+   int	 firstgate;	/* Net number of the first gate output */
+   int	 numnets;
+   int	*levelstart;	/* First gate of each level (depth + 1 entries) */
+   gate	*gates;
+   int	*fanout;	/* Fanout count of each net */
+   int	*reader;	/* Last gate reading each net, or -1 */
+   int	*flopd;		/* Net driving each flip-flop input */
+   int	*outd;		/* Net driving each primary output buffer */
+} netgen;
+
+/*--------------------------------------------------------------*/
+/* Random number generator (xorshift64*).  Returns a value in	*/
+/* the range 0 to (range - 1).					*/
+/*--------------------------------------------------------------*/
+
+unsigned long long randstate;
+
+int
+gen_random(int range)
+{
+    unsigned long long r;
+
+    randstate ^= randstate >> 12;
+    randstate ^= randstate << 25;
+    randstate ^= randstate >> 27;
+    r = randstate * 0x2545F4914F6CDD1DULL;
+    return (int)((r >> 33) % (unsigned long long)range);
+}
+
+/*--------------------------------------------------------------*/
+/* Pick a cell for a combinational gate, by weight.		*/
+/*--------------------------------------------------------------*/
+
+int
+pick_cell()
+{
+    static int total = 0;
+    int i, r;
+
+    if (total == 0)
+	for (i = 0; gatecells[i].name != NULL; i++)
+	    total += gatecells[i].weight;
+
+    r = gen_random(total);
+    for (i = 0; gatecells[i + 1].name != NULL; i++) {
+	r -= gatecells[i].weight;
+	if (r < 0) break;
+    }
+    return i;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the net driven by any source on level "level".  Level	*/
+/* 0 is the primary inputs and flip-flop outputs.  Nets at the	*/
+/* maximum fanout are avoided, if possible.			*/
+/*--------------------------------------------------------------*/
+
+int
+pick_on_level(netgen *ng, int level)
+{
+    int net, first, count, tries;
+
+    if (level == 0) {
+	first = 1;
+	count = ng->numinputs + ng->numflops;
+    }
+    else {
+	first = ng->firstgate + ng->levelstart[level - 1];
+	count = ng->levelstart[level] - ng->levelstart[level - 1];
+    }
+    if (count <= 0) return 1 + gen_random(ng->numinputs);
+
+    for (tries = 0; tries < FANOUT_TRIES; tries++) {
+	net = first + gen_random(count);
+	if (ng->fanout[net] < ng->maxfanout) break;
+    }
+    return net;
+}
+
+/*--------------------------------------------------------------*/
+/* Choose the driver of input "idx" of gate "g".  The first	*/
+/* input is taken from the level just below, so that the logic	*/
+/* has the requested depth.  Other inputs come from one of a	*/
+/* few nearby levels, a high-fanout global net, or (for		*/
+/* reconvergence) an input of the gate driving the first input.	*/
+/*--------------------------------------------------------------*/
+
+int
+pick_driver(netgen *ng, int g, int idx)
+{
+    gate *gptr = ng->gates + g;
+    int level = gptr->level;
+    int first, span, r;
+
+    if (idx == 0) return pick_on_level(ng, level - 1);
+
+    r = gen_random(100);
+    if (r < ng->globalpct)
+	return 1 + gen_random((ng->numinputs < NUMGLOBAL) ? ng->numinputs : NUMGLOBAL);
+
+    if (r < ng->globalpct + ng->reconvpct) {
+	first = gptr->in[0] - ng->firstgate;
+	if (first >= 0) {
+	    gptr = ng->gates + first;
+	    return gptr->in[gen_random(gatecells[gptr->cell].numin)];
+	}
+    }
+
+    span = (level < 3) ? level : 3;
+    return pick_on_level(ng, level - 1 - gen_random(span));
+}
+
+/*--------------------------------------------------------------*/
+/* Close a combinational loop:  Follow the readers of a gate	*/
+/* output forward a few steps, and feed the output of the last	*/
+/* gate reached back into the first gate.  Gates already in a	*/
+/* loop are not used again, so that no loop breaks another.	*/
+/* Return 1 if a loop was made, 0 if not.			*/
+/*--------------------------------------------------------------*/
+
+int
+make_loop(netgen *ng)
+{
+    int g, h, next, steps, i, idx;
+    gate *gptr;
+
+    g = gen_random(ng->numgates);
+    if (ng->gates[g].inloop) return 0;
+
+    h = g;
+    steps = 1 + gen_random(4);
+    for (i = 0; i < steps; i++) {
+	next = ng->reader[ng->firstgate + h];
+	if ((next < 0) || (next == g) || ng->gates[next].inloop) break;
+	h = next;
+    }
+    if (h == g) return 0;
+
+    // Mark the gates in the loop
+
+    ng->gates[g].inloop = 1;
+    for (next = g; next != h; ) {
+	next = ng->reader[ng->firstgate + next];
+	ng->gates[next].inloop = 1;
+    }
+
+    gptr = ng->gates + g;
+    idx = gatecells[gptr->cell].numin - 1;
+    gptr->in[idx] = ng->firstgate + h;
+    return 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Build the netlist.						*/
+/*--------------------------------------------------------------*/
+
+void
+generate_netlist(netgen *ng)
+{
+    gate *gptr;
+    int g, i, j, k, net, numin, made, tries;
+
+    ng->firstflop = 1 + ng->numinputs;
+    ng->firstgate = ng->firstflop + ng->numflops;
+    ng->numnets = ng->firstgate + ng->numgates;
+
+    ng->gates = (gate *)calloc(ng->numgates, sizeof(gate));
+    ng->fanout = (int *)calloc(ng->numnets, sizeof(int));
+    ng->reader = (int *)malloc(ng->numnets * sizeof(int));
+    for (i = 0; i < ng->numnets; i++) ng->reader[i] = -1;
+    ng->flopd = (int *)malloc(ng->numflops * sizeof(int));
+    ng->outd = (int *)malloc(ng->numoutputs * sizeof(int));
+
+    // Divide the gates evenly among the levels
+
+    ng->levelstart = (int *)malloc((ng->depth + 1) * sizeof(int));
+    for (i = 0; i <= ng->depth; i++)
+	ng->levelstart[i] = (int)(((long long)ng->numgates * i) / ng->depth);
+
+    for (i = 0; i < ng->depth; i++) {
+	for (g = ng->levelstart[i]; g < ng->levelstart[i + 1]; g++) {
+	    gptr = ng->gates + g;
+	    gptr->level = i + 1;
+	    gptr->cell = pick_cell();
+	    numin = gatecells[gptr->cell].numin;
+	    for (j = 0; j < numin; j++) {
+		net = pick_driver(ng, g, j);
+
+		// Do not connect the same net to two inputs of one gate
+		for (k = 0; k < j; k++)
+		    if (gptr->in[k] == net) break;
+		if (k < j) net = pick_on_level(ng, 0);
+
+		gptr->in[j] = net;
+		ng->fanout[net]++;
+		ng->reader[net] = g;
+	    }
+	}
+    }
+
+    // Flip-flop inputs take unused gate outputs first, starting
+    // from the deepest level, then any gate on the top levels.
+
+    net = ng->numnets - 1;
+    for (i = 0; i < ng->numflops; i++) {
+	while ((net >= ng->firstgate) && (ng->fanout[net] > 0)) net--;
+	if (net >= ng->firstgate)
+	    ng->flopd[i] = net--;
+	else
+	    ng->flopd[i] = pick_on_level(ng, ng->depth - gen_random(
+			(ng->depth < 3) ? ng->depth : 3));
+	ng->fanout[ng->flopd[i]]++;
+    }
+
+    for (i = 0; i < ng->numoutputs; i++) {
+	ng->outd[i] = pick_on_level(ng, ng->depth);
+	ng->fanout[ng->outd[i]]++;
+    }
+
+    // Loops are made last, as they rewire gates already connected
+
+    made = 0;
+    for (tries = 0; (made < ng->numloops) && (tries < 100 * ng->numloops); tries++)
+	made += make_loop(ng);
+    if (made < ng->numloops)
+	fprintf(stderr, "Only %d of %d loops could be made.\n", made, ng->numloops);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the name of net "net" to "f".				*/
+/*--------------------------------------------------------------*/
+
+void
+write_net(FILE *f, netgen *ng, int net)
+{
+    if (net == 0)
+	fputs("clk", f);
+    else if (net < ng->firstflop)
+	fprintf(f, "in%d", net - 1);
+    else if (net < ng->firstgate)
+	fprintf(f, "q%d", net - ng->firstflop);
+    else
+	fprintf(f, "n%d", net - ng->firstgate);
+}
+
+/*--------------------------------------------------------------*/
+/* Return the first flip-flop clocked by clock input "clk".	*/
+/* Clock "ng->numclocks" is one past the last flip-flop.	*/
+/*--------------------------------------------------------------*/
+
+int
+clock_first(netgen *ng, int clk)
+{
+    return (int)(((long long)clk * ng->numflops + ng->numclocks - 1) / ng->numclocks);
+}
+
+/*--------------------------------------------------------------*/
+/* Find the number of buffers on each level of a clock tree	*/
+/* with "loads" flip-flops in which no net has more than	*/
+/* "ng->clockfanout" loads, as clocktree.tcl would insert.	*/
+/* Level 0 buffers drive the flip-flops, and the buffers of	*/
+/* the last level are driven by the clock input.  Return the	*/
+/* number of levels.						*/
+/*--------------------------------------------------------------*/
+
+int
+clock_tree_levels(netgen *ng, int loads, int *count)
+{
+    int levels = 0;
+
+    if (ng->clockfanout < 2) return 0;
+    while ((loads > ng->clockfanout) && (levels < MAXCLKLEVELS)) {
+	count[levels] = (loads + ng->clockfanout - 1) / ng->clockfanout;
+	loads = count[levels++];
+    }
+    return levels;
+}
+
+/*--------------------------------------------------------------*/
+/* Write the name of clock input "clk".  With a single clock,	*/
+/* it is "clk";  otherwise the clocks are numbered.		*/
+/*--------------------------------------------------------------*/
+
+void
+write_clock_input(FILE *f, netgen *ng, int clk)
+{
+    if (ng->numclocks == 1)
+	fputs("clk", f);
+    else
+	fprintf(f, "clk%d", clk);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the name of the clock net of clock "clk" driving load	*/
+/* "idx" on level "level" of its clock tree (level 0 being the	*/
+/* flip-flops).  Buffers are named likewise, with "prefix"	*/
+/* "cb" in place of "ck".					*/
+/*--------------------------------------------------------------*/
+
+void
+write_clock_net(FILE *f, netgen *ng, char *prefix, int clk, int levels,
+		int level, int idx)
+{
+    if (level >= levels)
+	write_clock_input(f, ng, clk);
+    else if (ng->numclocks == 1)
+	fprintf(f, "%s%d_%d", prefix, level, idx / ng->clockfanout);
+    else
+	fprintf(f, "%s%d_%d_%d", prefix, clk, level, idx / ng->clockfanout);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the netlist as structural verilog.			*/
+/*--------------------------------------------------------------*/
+
+void
+write_netlist(FILE *f, netgen *ng, char *modname)
+{
+    gate *gptr;
+    gatecell *cptr;
+    int i, j, k, first, levels, count[MAXCLKLEVELS];
+
+    fprintf(f, "// Synthetic benchmark netlist generated by vestagen\n");
+    fprintf(f, "// %d gates, %d flip-flops, %d inputs, %d outputs, depth %d\n\n",
+		ng->numgates, ng->numflops, ng->numinputs, ng->numoutputs,
+		ng->depth);
+
+    fprintf(f, "module %s (", modname);
+    for (k = 0; k < ng->numclocks; k++) {
+	if (k > 0) fprintf(f, ", ");
+	write_clock_input(f, ng, k);
+    }
+    for (i = 0; i < ng->numinputs; i++) fprintf(f, ", in%d", i);
+    for (i = 0; i < ng->numoutputs; i++) fprintf(f, ", out%d", i);
+    fprintf(f, ");\n\n");
+
+    for (k = 0; k < ng->numclocks; k++) {
+	fprintf(f, "input ");
+	write_clock_input(f, ng, k);
+	fprintf(f, ";\n");
+    }
+    for (i = 0; i < ng->numinputs; i++) fprintf(f, "input in%d;\n", i);
+    for (i = 0; i < ng->numoutputs; i++) fprintf(f, "output out%d;\n", i);
+    fprintf(f, "\n");
+
+    for (i = ng->firstflop; i < ng->numnets; i++) {
+	fprintf(f, "wire ");
+	write_net(f, ng, i);
+	fprintf(f, ";\n");
+    }
+    for (k = 0; k < ng->numclocks; k++) {
+	levels = clock_tree_levels(ng, clock_first(ng, k + 1) - clock_first(ng, k),
+			count);
+	for (i = 0; i < levels; i++) {
+	    for (j = 0; j < count[i]; j++) {
+		fprintf(f, "wire ");
+		write_clock_net(f, ng, "ck", k, levels, i, j * ng->clockfanout);
+		fprintf(f, ";\n");
+	    }
+	}
+    }
+    fprintf(f, "\n");
+
+    for (k = 0; k < ng->numclocks; k++) {
+	levels = clock_tree_levels(ng, clock_first(ng, k + 1) - clock_first(ng, k),
+			count);
+	for (i = 0; i < levels; i++) {
+	    for (j = 0; j < count[i]; j++) {
+		fprintf(f, "%s ", CLKBUFCELL);
+		write_clock_net(f, ng, "cb", k, levels, i, j * ng->clockfanout);
+		fprintf(f, " (.A(");
+		write_clock_net(f, ng, "ck", k, levels, i + 1, j);
+		fprintf(f, "), .Y(");
+		write_clock_net(f, ng, "ck", k, levels, i, j * ng->clockfanout);
+		fprintf(f, "));\n");
+	    }
+	}
+    }
+
+    for (i = 0; i < ng->numgates; i++) {
+	gptr = ng->gates + i;
+	cptr = gatecells + gptr->cell;
+	fprintf(f, "%s g%d (", cptr->name, i);
+	for (j = 0; j < cptr->numin; j++) {
+	    fprintf(f, ".%s(", cptr->pins[j]);
+	    write_net(f, ng, gptr->in[j]);
+	    fprintf(f, "), ");
+	}
+	fprintf(f, ".%s(", cptr->out);
+	write_net(f, ng, ng->firstgate + i);
+	fprintf(f, "));\n");
+    }
+
+    for (k = 0; k < ng->numclocks; k++) {
+	first = clock_first(ng, k);
+	levels = clock_tree_levels(ng, clock_first(ng, k + 1) - first, count);
+	for (i = first; i < clock_first(ng, k + 1); i++) {
+	    fprintf(f, "%s f%d (.CLK(", FLOPCELL, i);
+	    write_clock_net(f, ng, "ck", k, levels, 0, i - first);
+	    fprintf(f, "), .D(");
+	    write_net(f, ng, ng->flopd[i]);
+	    fprintf(f, "), .Q(q%d));\n", i);
+	}
+    }
+
+    for (i = 0; i < ng->numoutputs; i++) {
+	fprintf(f, "%s ob%d (.A(", BUFCELL, i);
+	write_net(f, ng, ng->outd[i]);
+	fprintf(f, "), .Y(out%d));\n", i);
+    }
+    fprintf(f, "\nendmodule\n");
+}
+
+/*--------------------------------------------------------------*/
+/* Main program							*/
+/*--------------------------------------------------------------*/
+
+int
+main(int objc, char *argv[])
+{
+    FILE *fout;
+    netgen ng;
+    int numinst = 1000;
+    int floppct = 10;
+    int seed = 1;
+    char *modname = "top";
+    int firstarg = 1;
+    int ival;
+
+    ng.numinputs = 32;
+    ng.numoutputs = 32;
+    ng.depth = 20;
+    ng.maxfanout = 8;
+    ng.globalpct = 2;
+    ng.reconvpct = 20;
+    ng.numloops = 0;
+    ng.clockfanout = 0;
+    ng.numclocks = 1;
+
+    while ((firstarg < objc) && (*argv[firstarg] == '-') && (argv[firstarg][1] != '\0')) {
+	if (firstarg + 1 >= objc) {
+	    fprintf(stderr, "Option \"%s\" requires a value\n", argv[firstarg]);
+	    exit(1);
+	}
+	ival = atoi(argv[firstarg + 1]);
+	switch (argv[firstarg][1]) {
+	    case 'n': numinst = ival; break;
+	    case 'd': ng.depth = ival; break;
+	    case 'f': ng.maxfanout = ival; break;
+	    case 'g': ng.globalpct = ival; break;
+	    case 'r': floppct = ival; break;
+	    case 'c': ng.reconvpct = ival; break;
+	    case 'l': ng.numloops = ival; break;
+	    case 't': ng.clockfanout = ival; break;
+	    case 'k': ng.numclocks = ival; break;
+	    case 'i': ng.numinputs = ival; break;
+	    case 'o': ng.numoutputs = ival; break;
+	    case 's': seed = ival; break;
+	    case 'm': modname = argv[firstarg + 1]; break;
+	    default:
+		fprintf(stderr, "Usage:  vestagen [options] [<name.v>]\n");
+		fprintf(stderr, "Options:\n");
+		fprintf(stderr, "-n <instances>  -d <depth>  -f <max fanout>\n");
+		fprintf(stderr, "-g <global %%>  -r <flop %%>  -c <reconvergent %%>\n");
+		fprintf(stderr, "-l <loops>  -i <inputs>  -o <outputs>\n");
+		fprintf(stderr, "-t <clock tree fanout>  -k <clocks>\n");
+		fprintf(stderr, "-s <seed>  -m <module name>\n");
+		exit(1);
+	}
+	firstarg += 2;
+    }
+
+    if (ng.depth < 1) ng.depth = 1;
+    if (ng.maxfanout < 1) ng.maxfanout = 1;
+    if (ng.numinputs < 1) ng.numinputs = 1;
+    if (ng.numoutputs < 0) ng.numoutputs = 0;
+    if ((floppct < 0) || (floppct > 90)) floppct = 10;
+    if (ng.numclocks < 1) ng.numclocks = 1;
+
+    ng.numflops = (int)(((long long)numinst * floppct) / 100);
+    ng.numgates = numinst - ng.numflops - ng.numoutputs;
+    if (ng.numgates < ng.depth) {
+	fprintf(stderr, "Too few instances (%d) for depth %d\n", numinst, ng.depth);
+	exit(1);
+    }
+
+    randstate = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)seed;
+    if (randstate == 0) randstate = 1;
+
+    generate_netlist(&ng);
+
+    if (firstarg < objc) {
+	fout = fopen(argv[firstarg], "w");
+	if (fout == NULL) {
+	    fprintf(stderr, "Cannot open %s for writing\n", argv[firstarg]);
+	    exit(1);
+	}
+    }
+    else
+	fout = stdout;
+
+    write_netlist(fout, &ng, modname);
+    if (fout != stdout) fclose(fout);
+    return 0;
+}
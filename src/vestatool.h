@@ -0,0 +1,18 @@
+/*--------------------------------------------------------------*/
+/* vestatool.h ---						*/
+/*								*/
+/*	Routines of libvesta used only by the vesta program,	*/
+/*	which are not part of the C interface in vesta.h.	*/
+/*--------------------------------------------------------------*/
+
+#ifndef _VESTATOOL_H
+#define _VESTATOOL_H
+
+#include "vesta.h"
+
+// Time "count" lookups into the timing tables of each pin of the library
+// of a design, for the --bench-tables option
+
+extern int  vesta_bench_tables(vesta_design *des, int count);
+
+#endif /* _VESTATOOL_H */